@@ -3,45 +3,37 @@
 
 #include "AI_Anim.h"
 #include "AI_Pawn.h"
+#include "Components/SkeletalMeshComponent.h"
 
-//DEFINE_LOG_CATEGORY(LogMyAnimInstance);
-
-/*
-void UAI_Anim::NativeUpdateAnimation(float DeltaTime)
-{
-	Super::NativeUpdateAnimation(DeltaTime);
-
-	/*AAI_Pawn* Pawn = Cast<AAI_Pawn>(TryGetPawnOwner());
-	if (Pawn)
-	{
-		//int32 LandmarkId = 
-
-		FName BoneName = Pawn->GetBoneNameFromLandmarkId(LandmarkId);
-		FVector IKTargetPosition = CalculateIKPosition(Pawn, LandmarkId);
-
-		SetIKTarget(BoneName, IKTargetPosition);
-
-		UE_LOG(LogMyAnimInstance, Log, TEXT("Updated IK Target Position for Bone: %s"), *BoneName.ToString());
-	}#1#
-}
-*/
-
-/*FVector UMyAnimInstance::CalculateIKPosition(const AAI_Pawn* Pawn, int32 LandmarkId)
+void UAI_Anim::PreUpdateAnimation(float DeltaSeconds)
 {
-	if (!Pawn)
-		return FVector::ZeroVector;
-
-	return Pawn->GetPositionForLandmarkId(LandmarkId);
+	UpdateHandPoseSnapshot();
+	// 여기서 프록시가 노드들의 PreUpdate를 부른다.
+	Super::PreUpdateAnimation(DeltaSeconds);
 }
 
-void UMyAnimInstance::SetIKTarget(const FName& BoneName, const FVector& IKPosition)
+void UAI_Anim::UpdateHandPoseSnapshot()
 {
-	USkeletalMeshComponent* SkelMeshComp = GetSkelMeshComponent();
+	HandPoseSnapshot.bValid = false;
 
-	if (SkelMeshComp && SkelMeshComp->DoesSocketExist(BoneName))
+	const USkeletalMeshComponent* MeshComponent = GetSkelMeshComponent();
+	const AAI_Pawn* Pawn = MeshComponent ? Cast<AAI_Pawn>(MeshComponent->GetOwner()) : nullptr;
+	if (Pawn == nullptr)
 	{
-		SkelMeshComp->SetWorldLocation(IKPosition, false, (FHitResult*)nullptr, ETeleportType::TeleportPhysics);
+		return;
+	}
 
-		UE_LOG(LogMyAnimInstance, Log, TEXT("IK position for bone '%s' set to: %s."), *BoneName.ToString(), *IKPosition.ToString());
+	// 양손 메시가 같은 애님 블루프린트를 쓰므로 어느 메시인지로 손을 고른다.
+	const EHandedness Handedness = (MeshComponent == Pawn->LeftHandMesh) ? EHandedness::Left : EHandedness::Right;
+	const FHandFrame& Hand = Pawn->LatestHands[static_cast<int32>(Handedness)];
+	if (Hand.ValidMask == 0)
+	{
+		return;
 	}
-}*/
\ No newline at end of file
+
+	HandPoseSnapshot.Hand = Hand;
+	HandPoseSnapshot.Pose = Pawn->LatestHandPoses[static_cast<int32>(Handedness)];
+	// 랜드마크는 월드 축 기준이므로 컴포넌트 회전의 역으로 돌린다.
+	HandPoseSnapshot.LandmarkToComponent = MeshComponent->GetComponentQuat().Inverse();
+	HandPoseSnapshot.bValid = true;
+}
@@ -4,20 +4,25 @@
 #include "AI_Pawn.h"
 
 #include "ComponentReregisterContext.h"
-#include "EngineUtils.h"
 #include "Camera/CameraComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Engine/ScopedMovementUpdate.h"
 #include "EnhancedInputComponent.h" 
-#include "SocketClient.h"
+#include "HandTracking/HandTrackingBoneMap.h"
+#include "HandTracking/HandTrackingCalibration.h"
+#include "HandTracking/HandTrackingProtocol.h"
+#include "HandTracking/HandTrackingSettings.h"
+#include "HandTracking/HandTrackingStats.h"
 #include "GameFramework/SpringArmComponent.h"
 
-
 // Sets default values
 AAI_Pawn::AAI_Pawn()
 {
  	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// 지난 프레임 끝에 워커에서 구해 둔 손 자세를 물리 전에 적용한다.
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
 
 	SpringArmComponent = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArmComponent"));
 	SpringArmComponent->SetupAttachment(GetRootComponent());
@@ -61,6 +66,26 @@ void AAI_Pawn::BeginPlay()
 	
 	ReferencePosition = FVector::ZeroVector;
 	bHasReference = false;
+	Calibration = FHandTrackingCalibration::FromSettings();
+
+	const UHandTrackingSettings* HandTrackingSettings = GetDefault<UHandTrackingSettings>();
+	DisplayLatencyFrames = HandTrackingSettings->DisplayLatencyFrames;
+	HandPositionEpsilon = HandTrackingSettings->HandPositionEpsilon;
+	HandRotationEpsilon = HandTrackingSettings->HandRotationEpsilon;
+	FHandTrackingPosePipelineParams PipelineParams = FHandTrackingPosePipelineParams::FromSettings();
+	PipelineParams.Calibration = Calibration;
+	PipelineParams.MinLandmarkConfidence = MinLandmarkConfidence;
+	HandPosePipeline = MakeShared<FHandTrackingPosePipeline, ESPMode::ThreadSafe>(HandTrackingStreamId, PipelineParams);
+	QueuedFrameCount = 0;
+	AppliedFrameCount = 0;
+	// 손 메시 애니메이션이 이번 틱에 적용한 자세를 읽도록 폰 틱 뒤에 돈다 (UAI_Anim::PreUpdateAnimation).
+	for (USkeletalMeshComponent* HandMesh : { LeftHandMesh, RightHandMesh })
+	{
+		if (HandMesh)
+		{
+			HandMesh->PrimaryComponentTick.AddPrerequisite(this, PrimaryActorTick);
+		}
+	}
 	
 	// 인풋 매핑 컨트롤 
 	if (APlayerController* PlayerController = Cast<APlayerController>( Controller ))
@@ -70,9 +95,12 @@ void AAI_Pawn::BeginPlay()
 			Subsystem->AddMappingContext( IMC_AI , 0 );
 		}
 	}
-	for (TActorIterator<ASocketClient> It(GetWorld(), ASocketClient::StaticClass()); It; ++It)
+	// 프레임은 서브시스템이 디코딩 태스크 뒤에 파이프라인을 이어 붙여 밀어 준다. 트래커가 늦게 뜨거나 재시작해도 수신 스레드가 알아서 다시 붙으므로 상태만 구독
+	if (UHandTrackingSubsystem* HandTracking = UHandTrackingSubsystem::Get(this))
 	{
-		SocketClient = *It;
+		HandTracking->RegisterPosePipeline(HandPosePipeline.ToSharedRef(), FSimpleDelegate::CreateUObject(this, &AAI_Pawn::OnHandTrackingFrameQueued));
+		HandTracking->OnConnectionStateChanged.AddDynamic(this, &AAI_Pawn::OnTrackingConnectionStateChanged);
+		bTrackingConnected = HandTracking->GetConnectionState() == EHandTrackingConnectionState::Connected;
 	}
 	// 카메라의 초기 위치 저장
 	InitialCameraLocation = CameraComponent->GetComponentLocation();
@@ -87,6 +115,21 @@ void AAI_Pawn::BeginPlay()
 	UE_LOG(LogTemp, Log, TEXT("Hand Mesh Offset From Camera: %s"), *HandMeshOffsetFromCamera.ToString());
 }
 
+void AAI_Pawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UHandTrackingSubsystem* HandTracking = UHandTrackingSubsystem::Get(this))
+	{
+		if (HandPosePipeline.IsValid())
+		{
+			HandTracking->UnregisterPosePipeline(HandPosePipeline.ToSharedRef());
+		}
+		HandTracking->OnConnectionStateChanged.RemoveDynamic(this, &AAI_Pawn::OnTrackingConnectionStateChanged);
+	}
+	// 걸려 있는 태스크가 끝나야 파이프라인을 놓을 수 있다 (소멸자가 기다린다).
+	HandPosePipeline.Reset();
+	Super::EndPlay(EndPlayReason);
+}
+
 // Called every frame
 void AAI_Pawn::Tick(float DeltaTime)
 {
@@ -96,13 +139,51 @@ void AAI_Pawn::Tick(float DeltaTime)
 	{
 		ReferencePosition = RightHandMesh->GetSocketLocation(TEXT("wrist_inner_r"));
 	}
-	if(SocketClient != nullptr)
+
+	if (!HandPosePipeline.IsValid())
+	{
+		return;
+	}
+
+	// 게임 스레드에서는 워커가 구해 둔 자세를 교환 한 번으로 받아 컴포넌트에만 적용한다.
+	bool bHandsMoving = true;
+	if (const FHandTrackingPipelineSnapshot* Snapshot = HandPosePipeline->AcquireLatest())
+	{
+		ApplyPoseSnapshot(*Snapshot);
+		// 넣은 프레임이 아직 반영되지 않았으면 멈춘 것으로 보지 않는다.
+		bHandsMoving = Snapshot->bStillMoving || Snapshot->FrameCount != QueuedFrameCount;
+	}
+
+	if (!bHandsMoving && !bHasReference)
+	{
+		// 손이 다 멈췄으면 다음 프레임이 올 때까지 틱을 끈다 (OnHandTrackingFrameQueued에서 다시 켠다).
+		SetActorTickEnabled(false);
+		return;
+	}
+	// 새 프레임이 없는 틱에도 다음 틱에 적용할 손을 그 프레임이 화면에 나올 시각에 맞춰 워커에서 다시 구한다.
+	HandPosePipeline->RequestDisplayTime(GetNextDisplayTime(DeltaTime));
+}
+
+void AAI_Pawn::OnHandTrackingFrameQueued()
+{
+	++QueuedFrameCount;
+	// 틱을 꺼 두었으면 마지막으로 알려 준 표시 시각이 오래되었으므로 새로 알린다. 파이프라인은 이 요청 다음에 프레임을 반영한다.
+	if (!IsActorTickEnabled() && HandPosePipeline.IsValid())
 	{
-		FString ReceivedData ;
-		SocketClient->ReceiveData(ReceivedData);
-		UE_LOG(LogInput,Log,TEXT("recData:%s"),*ReceivedData)
-		ParseAndApplyHandTrackingData(ReceivedData);
+		const UWorld* World = GetWorld();
+		HandPosePipeline->RequestDisplayTime(GetNextDisplayTime(World ? World->GetDeltaSeconds() : 0.0f));
 	}
+	SetActorTickEnabled(true);
+}
+
+double AAI_Pawn::GetNextDisplayTime(float DeltaTime) const
+{
+	return FPlatformTime::Seconds() + DeltaTime * (1.0f + DisplayLatencyFrames);
+}
+
+void AAI_Pawn::OnTrackingConnectionStateChanged(EHandTrackingConnectionState NewState)
+{
+	bTrackingConnected = (NewState == EHandTrackingConnectionState::Connected);
 }
 
 // Called to bind functionality to input
@@ -127,155 +208,116 @@ void AAI_Pawn::RotateCamera(const FInputActionValue& Value)
 	
 FName AAI_Pawn::GetBoneNameFromLandmarkId(int32 LandmarkId, const FString& HandType) const
 {
-	 // 오른손에 대한 본 이름 매핑
-    if (HandType == "Right")
-    {
-        switch (LandmarkId)
-        {
-        case 0: return FName(TEXT("wrist_inner_r"));
-        case 1: return FName(TEXT("thumb_01_r"));
-        case 2: return FName(TEXT("thumb_02_r"));
-        case 3: return FName(TEXT("thumb_03_r"));
-        case 5: return FName(TEXT("index_01_r"));
-        case 6: return FName(TEXT("index_02_r"));
-        case 7: return FName(TEXT("index_03_r"));
-        case 9: return FName(TEXT("middle_01_r"));
-        case 10: return FName(TEXT("middle_02_r"));
-        case 11: return FName(TEXT("middle_03_r"));
-        case 13: return FName(TEXT("pinky_01_r"));
-        case 14: return FName(TEXT("pinky_02_r"));
-        case 15: return FName(TEXT("pinky_03_r"));
-        case 17: return FName(TEXT("ring_01_r"));
-        case 18: return FName(TEXT("ring_02_r"));
-        case 19: return FName(TEXT("ring_03_r"));
-        default: return FName(); // ID가 매핑되지 않은 경우, 빈 FName 반환
-        }
-    }
-    // 왼손에 대한 본 이름 매핑
-    else if (HandType == "Left")
-    {
-        switch (LandmarkId)
-        {
-        case 0: return FName(TEXT("wrist_inner_l"));
-        case 1: return FName(TEXT("thumb_01_l"));
-        case 2: return FName(TEXT("thumb_02_l"));
-        case 3: return FName(TEXT("thumb_03_l"));
-        case 5: return FName(TEXT("index_01_l"));
-        case 6: return FName(TEXT("index_02_l"));
-        case 7: return FName(TEXT("index_03_l"));
-        case 9: return FName(TEXT("middle_01_l"));
-        case 10: return FName(TEXT("middle_02_l"));
-        case 11: return FName(TEXT("middle_03_l"));
-        case 13: return FName(TEXT("pinky_01_l"));
-        case 14: return FName(TEXT("pinky_02_l"));
-        case 15: return FName(TEXT("pinky_03_l"));
-        case 17: return FName(TEXT("ring_01_l"));
-        case 18: return FName(TEXT("ring_02_l"));
-        case 19: return FName(TEXT("ring_03_l"));
-        default: return FName(); // ID가 매핑되지 않은 경우, 빈 FName 반환
-        }
-    }
-
-    // 예외 처리: 만약 HandType이 "Right" 또는 "Left"가 아닐 경우
-    return FName(); // 빈 FName 반환
+	if (HandType.Equals(TEXT("Left"), ESearchCase::IgnoreCase))
+	{
+		return GetBoneName(LandmarkId, EHandedness::Left);
+	}
+	if (HandType.Equals(TEXT("Right"), ESearchCase::IgnoreCase))
+	{
+		return GetBoneName(LandmarkId, EHandedness::Right);
+	}
+	// 예외 처리: 만약 HandType이 "Right" 또는 "Left"가 아닐 경우
+	return FName(); // 빈 FName 반환
 }
 
-void AAI_Pawn::ParseAndApplyHandTrackingData(const FString& ReceivedData)
+FName AAI_Pawn::GetBoneName(int32 LandmarkId, EHandedness Handedness) const
 {
-	UE_LOG(LogTemp, Log, TEXT("ParseAndApplyHandTrackingData called with data: %s"), *ReceivedData);
+	return FHandTrackingBoneMap::GetBoneName(Handedness, LandmarkId);
+}
 
-	TSharedPtr<FJsonObject> JsonObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ReceivedData);
-	TMap<int32, FVector> BoneIdToPositionMap;
+USkeletalMeshComponent* AAI_Pawn::GetHandMesh(EHandedness Handedness) const
+{
+	return (Handedness == EHandedness::Left) ? LeftHandMesh : RightHandMesh;
+}
 
-	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+void AAI_Pawn::ApplyPoseSnapshot(const FHandTrackingPipelineSnapshot& Snapshot)
+{
+	for (int32 HandIndex = 0; HandIndex < MaxTrackedHands; ++HandIndex)
 	{
-		const TArray<TSharedPtr<FJsonValue>>* HandsArray;
-		if (JsonObject->TryGetArrayField(TEXT("hands"), HandsArray))
+		const FHandFrame& Hand = Snapshot.Hands[HandIndex];
+		// 지난 틱과 똑같은 손은 메시를 건드리지 않는다.
+		if (Hand.ValidMask == 0 || Hand.Equals(LatestHands[HandIndex]))
 		{
-			for (const auto& HandValue : *HandsArray)
-			{
-				FString HandType = HandValue->AsObject()->GetStringField(TEXT("type"));
-				auto& Landmarks = HandValue->AsObject()->GetArrayField(TEXT("landmarks"));
-
-				FVector TotalPosition = FVector::ZeroVector;
-				int32 Count = 0;
-
-				for (const auto& Landmark : Landmarks)
-				{
-					auto LandmarkObj = Landmark->AsObject();
-					int32 Id = LandmarkObj->GetIntegerField(TEXT("id"));
-					float X = LandmarkObj->GetNumberField(TEXT("x"));
-					float Y = LandmarkObj->GetNumberField(TEXT("y"));
-					float Z = LandmarkObj->GetNumberField(TEXT("z"));
-
-					FVector UnrealPosition = ConvertPythonToUnreal(X, Y, Z);
-					UE_LOG(LogTemp, Log, TEXT("Converted Unreal Position for %s Hand ID %d: %s"), *HandType, Id, *UnrealPosition.ToString());
-
-					// 초기 손 위치에 대한 웹캠 데이터의 상대 위치 적용
-					FVector InitialHandLocation = (HandType.Equals("Left", ESearchCase::IgnoreCase)) ? InitialLeftHandLocation : InitialRightHandLocation;
-					FVector NewHandPosition = InitialHandLocation + (UnrealPosition - InitialHandLocation);
-					UE_LOG(LogTemp, Log, TEXT("New Hand Position for %s Hand ID %d: %s"), *HandType, Id, *NewHandPosition.ToString());
-
-					UpdateBonePositions(BoneIdToPositionMap, "Left");  
-					UpdateBonePositions(BoneIdToPositionMap, "Right");  
-					
-					// 위치와 카운트를 업데이트
-					TotalPosition += UnrealPosition;
-					Count++;
-				}
-				if (Count > 0)
-				{
-					FVector AveragePosition = TotalPosition / static_cast<float>(Count);
-					FRotator AverageRotation; // 평균 회전 계산 로직 필요
-					UpdateHandMeshPosition(HandType, AveragePosition, AverageRotation);
-				}
-			}
+			continue;
 		}
-	}
-}
+		LatestHands[HandIndex] = Hand;
 
-FVector AAI_Pawn::ConvertPythonToUnreal(float PixelX, float PixelY, float PixelZ)
-{
-	// 웹캠 해상도의 최대값을 정의
-	const float MaxWebcamX = 600.0f;
-	const float MaxWebcamY = 580.0f;
+		// 위치 합산 (들어온 랜드마크만)
+		FVector TotalPosition = FVector::ZeroVector;
+		for (uint32 Mask = Hand.ValidMask; Mask != 0; Mask &= Mask - 1)
+		{
+			const int32 Id = FMath::CountTrailingZeros(Mask);
+			TotalPosition += FVector(Hand.X[Id], Hand.Y[Id], Hand.Z[Id]);
+		}
 
-	// 웹캠 해상도의 중앙값을 정의
-	const float CenterX = MaxWebcamX / 2.0f;
-	const float CenterY = MaxWebcamY / 2.0f;
+		FVector AveragePosition = TotalPosition / static_cast<float>(Hand.GetNumValidLandmarks());
+		FRotator AverageRotation; // 평균 회전 계산 로직 필요
+		{
+			HANDTRACKING_SCOPE(Apply);
+			UpdateHandMeshPosition(Hand.Handedness, AveragePosition, AverageRotation);
+		}
+	}
 
-	// 웹캠에서의 픽셀 단위를 언리얼 엔진의 월드 스케일로 변환할 스케일 인자를 정의
-	const float ConversionScaleXY = 0.05f; // x와 y축 변환에 사용될 스케일 인자
-	const float ConversionScaleZ = 0.05f; // z축 변환에 사용될 스케일 인자
+	// 손가락 자세는 UAI_Anim을 거쳐 FAnimNode_HandTrackingPose가 본에 적용한다.
+	for (int32 HandIndex = 0; HandIndex < MaxTrackedHands; ++HandIndex)
+	{
+		LatestHandPoses[HandIndex] = Snapshot.Poses[HandIndex];
+		LatestJitterStats[HandIndex] = Snapshot.JitterStats[HandIndex];
+	}
 
-	// 웹캠의 픽셀 좌표를 언리얼의 월드 좌표계로 변환
-	// 여기서, 웹캠의 x축은 언리얼의 y축으로, 웹캠의 y축은 언리얼의 z축으로 매핑되며,
-	// 웹캠의 z축은 언리얼의 x축으로 매핑
-	
-	float UnrealY = (PixelX - CenterX) * ConversionScaleXY * 2 + 15; // 웹캠 왼쪽이 마이너스, 오른쪽이 플러스 방향
-	float UnrealZ = (CenterY - PixelY) * ConversionScaleXY; // 웹캠 상단이 마이너스, 하단이 플러스 방향
-	float UnrealX = PixelZ * ConversionScaleZ; // 웹캠에 가까울수록 언리얼에서 멀어지는 방향(양의 X 방향)
+	if (Snapshot.FrameCount != AppliedFrameCount)
+	{
+		AppliedFrameCount = Snapshot.FrameCount;
+		RecordFrameLatency(Snapshot.ArrivalTime, Snapshot.CaptureTime);
+	}
+}
 
-	FVector ConvertedPosition = FVector(UnrealX, UnrealY, UnrealZ);
-	UE_LOG(LogActorComponent, Log, TEXT("ConvertPythonToUnreal called with PixelX: %f, PixelY: %f, PixelZ: %f"), PixelX, PixelY, PixelZ);
-	UE_LOG(LogActorComponent, Log, TEXT("Converted Unreal Position: %s"), *ConvertedPosition.ToString());
-	UE_LOG(LogActorComponent, Log, TEXT("ConversionScale used: XY: %f, Z: %f"), ConversionScaleXY, ConversionScaleZ);
+void AAI_Pawn::RecordFrameLatency(double ArrivalTime, double CaptureTime)
+{
+	const double AppliedTime = FPlatformTime::Seconds();
+	if (ArrivalTime > 0.0)
+	{
+		ReceiveToApplyLatency.AddSample(AppliedTime - ArrivalTime);
+	}
+	if (CaptureTime > 0.0)
+	{
+		// 시계 추정 오차로 아주 조금 음수가 나올 수 있다.
+		CaptureToApplyLatency.AddSample(FMath::Max(AppliedTime - CaptureTime, 0.0));
+		if (ArrivalTime > 0.0)
+		{
+			CaptureToReceiveLatency.AddSample(FMath::Max(ArrivalTime - CaptureTime, 0.0));
+		}
+	}
 
-	return ConvertedPosition;
+#if STATS
+	const FHandTrackingLatencyStats& CaptureStats = CaptureToApplyLatency.GetStats();
+	SET_FLOAT_STAT(STAT_HandTracking_EndToEndP50, CaptureStats.P50Ms);
+	SET_FLOAT_STAT(STAT_HandTracking_EndToEndP95, CaptureStats.P95Ms);
+	SET_FLOAT_STAT(STAT_HandTracking_EndToEndP99, CaptureStats.P99Ms);
+
+	const FHandTrackingLatencyStats& NetworkStats = CaptureToReceiveLatency.GetStats();
+	SET_FLOAT_STAT(STAT_HandTracking_CaptureToReceiveP50, NetworkStats.P50Ms);
+	SET_FLOAT_STAT(STAT_HandTracking_CaptureToReceiveP95, NetworkStats.P95Ms);
+	SET_FLOAT_STAT(STAT_HandTracking_CaptureToReceiveP99, NetworkStats.P99Ms);
+
+	const FHandTrackingLatencyStats& ReceiveStats = ReceiveToApplyLatency.GetStats();
+	SET_FLOAT_STAT(STAT_HandTracking_ReceiveToApplyP50, ReceiveStats.P50Ms);
+	SET_FLOAT_STAT(STAT_HandTracking_ReceiveToApplyP95, ReceiveStats.P95Ms);
+	SET_FLOAT_STAT(STAT_HandTracking_ReceiveToApplyP99, ReceiveStats.P99Ms);
+#endif
 }
 
-void AAI_Pawn::UpdateHandMeshPosition(const FString& HandType, const FVector& NewPosition, const FRotator& NewRotation)
+FVector AAI_Pawn::ConvertPythonToUnreal(float PixelX, float PixelY, float PixelZ)
+{
+	// 보정 값은 UHandTrackingSettings (DefaultGame.ini) 참고
+	return FVector(Calibration.TransformPosition(FVector3f(PixelX, PixelY, PixelZ)));
+}
+
+void AAI_Pawn::UpdateHandMeshPosition(EHandedness Handedness, const FVector& NewPosition, const FRotator& NewRotation)
 {
 	if (!CameraComponent || !LeftHandMesh || !RightHandMesh) return;
 
-	USkeletalMeshComponent* HandMesh = nullptr;
-	if (HandType.Equals("Left", ESearchCase::IgnoreCase)) {
-		HandMesh = LeftHandMesh;
-	} else if (HandType.Equals("Right", ESearchCase::IgnoreCase)) {
-		HandMesh = RightHandMesh;
-	}
-	if (!HandMesh) return;
+	USkeletalMeshComponent* HandMesh = GetHandMesh(Handedness);
 	
 	// 웹캠 데이터 기반으로 계산된 핸드 메시의 새로운 위치를 계산
 	// 이때, HandMeshOffsetFromCamera를 사용하여 카메라 위치에 상대적인 위치를 고려
@@ -290,26 +332,39 @@ void AAI_Pawn::UpdateHandMeshPosition(const FString& HandType, const FVector& Ne
 	FQuat TargetQuat = FQuat(HandRotation); 
 	FQuat CurrentQuat = HandMesh->GetComponentQuat();
 	FQuat NewQuat = FQuat::Slerp(CurrentQuat, TargetQuat, RotationSpeed);
-	
-	// 핸드 메시의 새로운 위치와 조정된 회전으로 업데이트합니다.
-	HandMesh->SetWorldLocationAndRotation(NewWorldPosition , NewQuat);
-	HandMesh->SetRelativeRotation( FRotator(HandMesh->GetRelativeRotation().Pitch,270,HandMesh->GetRelativeRotation().Roll));
 
-	
-    UE_LOG(LogTemp, Log, TEXT("Updated %s Hand Mesh Position to %s and Adjusted Rotation"), *HandType, *NewWorldPosition.ToString());
-}
-
-void AAI_Pawn::UpdateBonePositions(const TMap<int32, FVector>& BoneIdToPositionMap, const FString& HandType)
-{
-	USkeletalMeshComponent* HandMesh = HandType.Equals("Left", ESearchCase::IgnoreCase) ? LeftHandMesh : RightHandMesh;
-	if (!HandMesh) return;
-
-	for (const auto& Pair : BoneIdToPositionMap)
+	// 월드 위치/회전을 부모 기준 상대 값으로 바꾸고 Yaw를 270으로 고정한 뒤 한 번에 적용한다.
+	// (예전: SetWorldLocationAndRotation 다음 SetRelativeRotation으로 자식까지 두 번 전파)
+	const FTransform ParentTransform = HandMesh->GetAttachParent()
+		? HandMesh->GetAttachParent()->GetSocketTransform(HandMesh->GetAttachSocketName())
+		: FTransform::Identity;
+	const FVector NewRelativeLocation = ParentTransform.InverseTransformPosition(NewWorldPosition);
+	FRotator NewRelativeRotation = ParentTransform.InverseTransformRotation(NewQuat).Rotator();
+	NewRelativeRotation.Yaw = 270.0;
+	const FQuat NewRelativeQuat = NewRelativeRotation.Quaternion();
+
+#if STATS
+	// 트랜스폼 전파 한 번마다 이 메시와 직접 붙은 자식들의 렌더 트랜스폼이 더러워진다.
+	const uint32 DirtiesPerUpdate = 1 + HandMesh->GetNumChildrenComponents();
+#endif
+	if (NewRelativeLocation.Equals(HandMesh->GetRelativeLocation(), HandPositionEpsilon)
+		&& NewRelativeQuat.AngularDistance(HandMesh->GetRelativeRotation().Quaternion()) <= FMath::DegreesToRadians(HandRotationEpsilon))
 	{
-		int32 BoneId = Pair.Key;
-		FVector BonePosition = Pair.Value;
+		INC_DWORD_STAT(STAT_HandTracking_TransformUpdatesSaved);
+		INC_DWORD_STAT_BY(STAT_HandTracking_RenderDirtiesSaved, 2 * DirtiesPerUpdate);
+		return;
+	}
 
-		FName BoneName = GetBoneNameFromLandmarkId(BoneId, HandType);
-		if (BoneName.IsNone()) continue;
+	{
+		// 오버랩/물리 갱신을 스코프 끝에서 한 번만 한다.
+		FScopedMovementUpdate ScopedUpdate(HandMesh, EScopedUpdate::DeferredUpdates);
+		HandMesh->SetRelativeLocationAndRotation(NewRelativeLocation, NewRelativeQuat);
 	}
+	INC_DWORD_STAT(STAT_HandTracking_TransformUpdates);
+	INC_DWORD_STAT_BY(STAT_HandTracking_RenderDirties, DirtiesPerUpdate);
+	// 예전에는 두 번 전파했다.
+	INC_DWORD_STAT_BY(STAT_HandTracking_RenderDirtiesSaved, DirtiesPerUpdate);
+
+	
+    UE_LOG(LogHandTracking, VeryVerbose, TEXT("Updated %s Hand Mesh Position to %s and Adjusted Rotation"), HandTrackingProtocol::GetHandednessName(Handedness), *NewWorldPosition.ToString());
 }
@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/AnimNode_HandTrackingPose.h"
+
+#include "AI_Anim.h"
+#include "HandTracking/HandTrackingBoneMap.h"
+#include "HandTracking/HandTrackingFingerSolver.h"
+#include "HandTracking/HandTrackingStats.h"
+
+void FAnimNode_HandTrackingPose::PreUpdate(const UAnimInstance* InAnimInstance)
+{
+	// 게임 스레드. 워커 스레드가 평가하는 동안 바뀌지 않도록 여기서 복사해 둔다.
+	if (const UAI_Anim* HandAnimInstance = Cast<UAI_Anim>(InAnimInstance))
+	{
+		Snapshot = HandAnimInstance->GetHandPoseSnapshot();
+	}
+	else
+	{
+		Snapshot.bValid = false;
+	}
+}
+
+void FAnimNode_HandTrackingPose::EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms)
+{
+	HANDTRACKING_SCOPE(Pose);
+
+	const FHandTrackingHandPose& Pose = Snapshot.Pose;
+	if (!Snapshot.bValid || !Pose.bPalmValid)
+	{
+		return;
+	}
+
+	const int32 HandIndex = static_cast<int32>(Snapshot.Hand.Handedness);
+	const FFingerChain* Chains = FingerChains[HandIndex];
+	const FBoneContainer& BoneContainer = Output.Pose.GetPose().GetBoneContainer();
+
+	const FCompactPoseBoneIndex HandRootIndex = HandRootBones[HandIndex].GetCompactPoseIndex(BoneContainer);
+	FTransform HandRootTransform = Output.Pose.GetComponentSpaceTransform(HandRootIndex);
+
+	FCompactPoseBoneIndex BoneIndices[NumFingers][BonesPerFinger];
+	FTransform BoneTransforms[NumFingers][BonesPerFinger];
+	for (int32 Finger = 0; Finger < NumFingers; ++Finger)
+	{
+		for (int32 BoneIndex = 0; BoneIndex < BonesPerFinger; ++BoneIndex)
+		{
+			BoneIndices[Finger][BoneIndex] = Chains[Finger].Bones[BoneIndex].GetCompactPoseIndex(BoneContainer);
+			BoneTransforms[Finger][BoneIndex] = Output.Pose.GetComponentSpaceTransform(BoneIndices[Finger][BoneIndex]);
+		}
+	}
+
+	// 현재 포즈의 손바닥 축을 랜드마크와 같은 방식(손 본, 검지/중지/새끼 뿌리)으로 구해 트래킹한 손바닥에 맞춘다.
+	FVector3f CurrentAxes[3];
+	if (!HandTrackingFingerSolver::ComputePalmAxes(FVector3f(HandRootTransform.GetLocation()),
+		FVector3f(BoneTransforms[1][0].GetLocation()), FVector3f(BoneTransforms[2][0].GetLocation()), FVector3f(BoneTransforms[4][0].GetLocation()),
+		CurrentAxes[0], CurrentAxes[1], CurrentAxes[2]))
+	{
+		return;
+	}
+	const FQuat CurrentPalm = FMatrix(FVector(CurrentAxes[0]), FVector(CurrentAxes[1]), FVector(CurrentAxes[2]), FVector::ZeroVector).ToQuat();
+	const FQuat TargetPalm = Snapshot.LandmarkToComponent * FQuat(Pose.PalmRotation);
+	const FQuat PalmDelta = (TargetPalm * CurrentPalm.Inverse()).GetNormalized();
+
+	auto RotateAbout = [](FTransform& Transform, const FQuat& Delta, const FVector& Pivot)
+	{
+		Transform.SetRotation((Delta * Transform.GetRotation()).GetNormalized());
+		Transform.SetLocation(Pivot + Delta.RotateVector(Transform.GetLocation() - Pivot));
+	};
+
+	const FVector HandRootLocation = HandRootTransform.GetLocation();
+	RotateAbout(HandRootTransform, PalmDelta, HandRootLocation);
+	for (FTransform (&FingerTransforms)[BonesPerFinger] : BoneTransforms)
+	{
+		for (FTransform& Transform : FingerTransforms)
+		{
+			RotateAbout(Transform, PalmDelta, HandRootLocation);
+		}
+	}
+	OutBoneTransforms.Add(FBoneTransform(HandRootIndex, HandRootTransform));
+
+	const FVector PalmX = TargetPalm.GetAxisX();
+	const FVector PalmY = TargetPalm.GetAxisY();
+	const FVector PalmZ = TargetPalm.GetAxisZ();
+
+	for (int32 Finger = 0; Finger < NumFingers; ++Finger)
+	{
+		if ((Pose.ValidFingerMask & (1u << Finger)) == 0)
+		{
+			// 손 본과 함께 돌아간 위치만 반영한다.
+			for (int32 BoneIndex = 0; BoneIndex < BonesPerFinger; ++BoneIndex)
+			{
+				OutBoneTransforms.Add(FBoneTransform(BoneIndices[Finger][BoneIndex], BoneTransforms[Finger][BoneIndex]));
+			}
+			continue;
+		}
+
+		const FFingerChain& Chain = Chains[Finger];
+		const FHandTrackingFingerPose& FingerPose = Pose.Fingers[Finger];
+		// 손가락 평면: 손바닥 위 손가락 방향과 -Z
+		const FVector PlaneForward = PalmX * FMath::Cos(FingerPose.Spread) + PalmY * FMath::Sin(FingerPose.Spread);
+
+		float Angle = 0.0f;
+		for (int32 BoneIndex = 0; BoneIndex < BonesPerFinger; ++BoneIndex)
+		{
+			Angle += FingerPose.Flex[BoneIndex];
+			const FVector Target = PlaneForward * FMath::Cos(Angle) - PalmZ * FMath::Sin(Angle);
+			const FVector Current = BoneTransforms[Finger][BoneIndex].GetRotation().RotateVector(Chain.LocalAxes[BoneIndex]);
+			const FQuat Delta = FQuat::FindBetweenNormals(Current, Target);
+			const FVector Pivot = BoneTransforms[Finger][BoneIndex].GetLocation();
+
+			// 이 마디의 회전을 끝 쪽 본에도 그대로 적용해 손가락 모양을 유지한다.
+			for (int32 ChildIndex = BoneIndex; ChildIndex < BonesPerFinger; ++ChildIndex)
+			{
+				RotateAbout(BoneTransforms[Finger][ChildIndex], Delta, Pivot);
+			}
+		}
+
+		for (int32 BoneIndex = 0; BoneIndex < BonesPerFinger; ++BoneIndex)
+		{
+			OutBoneTransforms.Add(FBoneTransform(BoneIndices[Finger][BoneIndex], BoneTransforms[Finger][BoneIndex]));
+		}
+	}
+
+	OutBoneTransforms.Sort(FCompareBoneTransformIndex());
+}
+
+bool FAnimNode_HandTrackingPose::IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones)
+{
+	// 손바닥 축을 구하려면 손 본과 모든 손가락 체인이 있어야 한다.
+	const int32 HandIndex = static_cast<int32>(Snapshot.Hand.Handedness);
+	if (!HandRootBones[HandIndex].IsValidToEvaluate(RequiredBones))
+	{
+		return false;
+	}
+	for (const FFingerChain& Chain : FingerChains[HandIndex])
+	{
+		if (!Chain.bValid)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FAnimNode_HandTrackingPose::InitializeBoneReferences(const FBoneContainer& RequiredBones)
+{
+	for (int32 HandIndex = 0; HandIndex < MaxTrackedHands; ++HandIndex)
+	{
+		HandRootBones[HandIndex].BoneName = FHandTrackingBoneMap::GetHandRootBoneName(static_cast<EHandedness>(HandIndex));
+		HandRootBones[HandIndex].Initialize(RequiredBones);
+
+		for (int32 FingerIndex = 0; FingerIndex < NumFingers; ++FingerIndex)
+		{
+			// 엄지 1, 검지 5, 중지 9, 약지 13, 새끼 17
+			FFingerChain& Chain = FingerChains[HandIndex][FingerIndex];
+			Chain.FirstLandmark = 1 + FingerIndex * (BonesPerFinger + 1);
+			Chain.bValid = true;
+
+			for (int32 BoneIndex = 0; BoneIndex < BonesPerFinger; ++BoneIndex)
+			{
+				FBoneReference& Bone = Chain.Bones[BoneIndex];
+				Bone.BoneName = FHandTrackingBoneMap::GetBoneName(static_cast<EHandedness>(HandIndex), Chain.FirstLandmark + BoneIndex);
+				Bone.Initialize(RequiredBones);
+				Chain.bValid &= Bone.IsValidToEvaluate(RequiredBones);
+			}
+			if (!Chain.bValid)
+			{
+				continue;
+			}
+
+			for (int32 BoneIndex = 0; BoneIndex < BonesPerFinger; ++BoneIndex)
+			{
+				FVector Axis;
+				if (BoneIndex + 1 < BonesPerFinger)
+				{
+					// 자식 본의 로컬 위치가 곧 이 본에서 다음 마디로 가는 방향
+					Axis = RequiredBones.GetRefPoseTransform(Chain.Bones[BoneIndex + 1].GetCompactPoseIndex(RequiredBones)).GetTranslation();
+				}
+				else
+				{
+					// 끝 마디는 자식 본이 없으므로 부모에서 이어지는 방향을 그대로 쓴다.
+					const FTransform& RefPose = RequiredBones.GetRefPoseTransform(Chain.Bones[BoneIndex].GetCompactPoseIndex(RequiredBones));
+					Axis = RefPose.GetRotation().UnrotateVector(RefPose.GetTranslation());
+				}
+				Chain.LocalAxes[BoneIndex] = Axis.GetSafeNormal(UE_SMALL_NUMBER, FVector::XAxisVector);
+			}
+		}
+	}
+}
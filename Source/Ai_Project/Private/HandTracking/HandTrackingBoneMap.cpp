@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingBoneMap.h"
+
+namespace
+{
+	// MannequinsXR 손 본 이름. 손가락 끝(4, 8, 12, 16, 20)은 대응하는 본이 없다.
+	constexpr const TCHAR* LandmarkBoneNames[MaxTrackedHands][HandLandmarkCount] =
+	{
+		// Left
+		{
+			TEXT("wrist_inner_l"),
+			TEXT("thumb_01_l"), TEXT("thumb_02_l"), TEXT("thumb_03_l"), nullptr,
+			TEXT("index_01_l"), TEXT("index_02_l"), TEXT("index_03_l"), nullptr,
+			TEXT("middle_01_l"), TEXT("middle_02_l"), TEXT("middle_03_l"), nullptr,
+			TEXT("ring_01_l"), TEXT("ring_02_l"), TEXT("ring_03_l"), nullptr,
+			TEXT("pinky_01_l"), TEXT("pinky_02_l"), TEXT("pinky_03_l"), nullptr,
+		},
+		// Right
+		{
+			TEXT("wrist_inner_r"),
+			TEXT("thumb_01_r"), TEXT("thumb_02_r"), TEXT("thumb_03_r"), nullptr,
+			TEXT("index_01_r"), TEXT("index_02_r"), TEXT("index_03_r"), nullptr,
+			TEXT("middle_01_r"), TEXT("middle_02_r"), TEXT("middle_03_r"), nullptr,
+			TEXT("ring_01_r"), TEXT("ring_02_r"), TEXT("ring_03_r"), nullptr,
+			TEXT("pinky_01_r"), TEXT("pinky_02_r"), TEXT("pinky_03_r"), nullptr,
+		},
+	};
+
+	constexpr const TCHAR* HandRootBoneNames[MaxTrackedHands] = { TEXT("hand_l"), TEXT("hand_r") };
+
+	struct FLandmarkBoneNameTable
+	{
+		FName Names[MaxTrackedHands][HandLandmarkCount];
+		FName HandRootNames[MaxTrackedHands];
+
+		FLandmarkBoneNameTable()
+		{
+			for (int32 HandIndex = 0; HandIndex < MaxTrackedHands; ++HandIndex)
+			{
+				HandRootNames[HandIndex] = FName(HandRootBoneNames[HandIndex]);
+				for (int32 Id = 0; Id < HandLandmarkCount; ++Id)
+				{
+					const TCHAR* Name = LandmarkBoneNames[HandIndex][Id];
+					Names[HandIndex][Id] = Name ? FName(Name) : NAME_None;
+				}
+			}
+		}
+	};
+
+	// FName은 처음 쓸 때 한 번만 만든다.
+	const FLandmarkBoneNameTable& GetLandmarkBoneNameTable()
+	{
+		static const FLandmarkBoneNameTable Table;
+		return Table;
+	}
+}
+
+FName FHandTrackingBoneMap::GetBoneName(EHandedness Handedness, int32 LandmarkId)
+{
+	if (LandmarkId < 0 || LandmarkId >= HandLandmarkCount)
+	{
+		return NAME_None;
+	}
+	return GetLandmarkBoneNameTable().Names[static_cast<int32>(Handedness)][LandmarkId];
+}
+
+FName FHandTrackingBoneMap::GetHandRootBoneName(EHandedness Handedness)
+{
+	return GetLandmarkBoneNameTable().HandRootNames[static_cast<int32>(Handedness)];
+}
@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingCalibration.h"
+
+#include "HandTracking/HandTrackingSettings.h"
+
+static_assert(FHandFrame::PaddedLandmarkCount % 4 == 0, "Landmark arrays must be padded to whole SIMD registers.");
+
+FHandTrackingCalibration::FHandTrackingCalibration()
+	: Matrix(FMatrix44f::Identity)
+{
+}
+
+FHandTrackingCalibration::FHandTrackingCalibration(const FMatrix44f& InMatrix)
+	: Matrix(InMatrix)
+{
+}
+
+FHandTrackingCalibration FHandTrackingCalibration::FromSettings()
+{
+	return FHandTrackingCalibration(GetDefault<UHandTrackingSettings>()->GetCalibrationMatrix());
+}
+
+void FHandTrackingCalibration::TransformHand(const FHandFrame& In, FHandFrame& Out) const
+{
+	// 행 벡터 규약: Out.C = x * M[0][C] + y * M[1][C] + z * M[2][C] + M[3][C]
+	// 행렬 원소를 레지스터 하나에 4번 복제해 두고, 랜드마크 4개의 같은 성분을 한 번에 곱한다.
+	VectorRegister4Float Columns[3][4];
+	for (int32 Column = 0; Column < 3; ++Column)
+	{
+		for (int32 Row = 0; Row < 4; ++Row)
+		{
+			Columns[Column][Row] = VectorSetFloat1(Matrix.M[Row][Column]);
+		}
+	}
+
+	float* OutComponents[3] = { Out.X, Out.Y, Out.Z };
+	for (int32 Base = 0; Base < FHandFrame::PaddedLandmarkCount; Base += 4)
+	{
+		// 다 읽은 뒤에 쓰므로 In과 Out이 같아도 된다.
+		const VectorRegister4Float X = VectorLoad(In.X + Base);
+		const VectorRegister4Float Y = VectorLoad(In.Y + Base);
+		const VectorRegister4Float Z = VectorLoad(In.Z + Base);
+
+		for (int32 Column = 0; Column < 3; ++Column)
+		{
+			const VectorRegister4Float* M = Columns[Column];
+			const VectorRegister4Float Result = VectorMultiplyAdd(X, M[0], VectorMultiplyAdd(Y, M[1], VectorMultiplyAdd(Z, M[2], M[3])));
+			VectorStore(Result, OutComponents[Column] + Base);
+		}
+	}
+
+	if (&In != &Out)
+	{
+		Out.Handedness = In.Handedness;
+		Out.ValidMask = In.ValidMask;
+		FMemory::Memcpy(Out.Confidence, In.Confidence, sizeof(Out.Confidence));
+	}
+}
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingClockSync.h"
+
+#include "Algo/Sort.h"
+#include "HandTracking/HandTrackingStats.h"
+
+bool FHandTrackingClockSync::AddReply(const FHandTrackingClockReply& Reply, double ReceiveTime)
+{
+	const double T0 = static_cast<double>(Reply.PingTimeUs) * 1.0e-6;
+	const double T1 = static_cast<double>(Reply.TrackerReceiveTimeUs) * 1.0e-6;
+	const double T2 = static_cast<double>(Reply.TrackerSendTimeUs) * 1.0e-6;
+	const double T3 = ReceiveTime;
+
+	const double RoundTrip = (T3 - T0) - (T2 - T1);
+	if (T0 <= 0.0 || T3 < T0 || T2 < T1 || RoundTrip < 0.0)
+	{
+		UE_LOG(LogHandTracking, Verbose, TEXT("Ignoring inconsistent clock reply #%u."), Reply.Sequence);
+		return false;
+	}
+
+	FSample Sample;
+	Sample.Time = 0.5 * (T0 + T3);
+	Sample.Offset = 0.5 * ((T1 - T0) + (T2 - T3));
+	Sample.RoundTrip = RoundTrip;
+
+	if (Estimate.IsValid())
+	{
+		const double Predicted = Estimate.Offset + Estimate.Drift * (Sample.Time - Estimate.ReferenceTime);
+		if (FMath::Abs(Sample.Offset - Predicted) > StepThreshold + 0.5 * RoundTrip)
+		{
+			UE_LOG(LogHandTracking, Log, TEXT("Hand tracker clock jumped by %.3f s, resynchronising."), Sample.Offset - Predicted);
+			Reset();
+		}
+	}
+
+	Samples[NextSample] = Sample;
+	NextSample = (NextSample + 1) % MaxSamples;
+	NumSamples = FMath::Min(NumSamples + 1, MaxSamples);
+
+	UpdateEstimate();
+	return true;
+}
+
+void FHandTrackingClockSync::Reset()
+{
+	NumSamples = 0;
+	NextSample = 0;
+	Estimate = FHandTrackingClockEstimate();
+}
+
+void FHandTrackingClockSync::UpdateEstimate()
+{
+	// 왕복이 짧은 순으로 앞쪽 일부만 쓴다. 큐에 오래 머문 표본은 오프셋이 한쪽으로 치우친다.
+	FSample Sorted[MaxSamples];
+	FMemory::Memcpy(Sorted, Samples, sizeof(FSample) * NumSamples);
+	Algo::Sort(MakeArrayView(Sorted, NumSamples), [](const FSample& A, const FSample& B) { return A.RoundTrip < B.RoundTrip; });
+	const int32 NumBest = FMath::Min(NumSamples, FMath::Max(NumSamples / BestSampleDivisor, 4));
+
+	double MinTime = Sorted[0].Time;
+	double MaxTime = Sorted[0].Time;
+	double MeanTime = 0.0;
+	double MeanOffset = 0.0;
+	for (int32 Index = 0; Index < NumBest; ++Index)
+	{
+		MinTime = FMath::Min(MinTime, Sorted[Index].Time);
+		MaxTime = FMath::Max(MaxTime, Sorted[Index].Time);
+		MeanTime += Sorted[Index].Time;
+		MeanOffset += Sorted[Index].Offset;
+	}
+	MeanTime /= NumBest;
+	MeanOffset /= NumBest;
+
+	// 최소제곱 직선. 평균 시각을 기준으로 잡아 큰 절대 시각끼리 빼는 오차를 피한다.
+	double Drift = 0.0;
+	if (NumBest >= 2 && MaxTime - MinTime >= DriftMinSpan)
+	{
+		double Covariance = 0.0;
+		double Variance = 0.0;
+		for (int32 Index = 0; Index < NumBest; ++Index)
+		{
+			const double DeltaTime = Sorted[Index].Time - MeanTime;
+			Covariance += DeltaTime * (Sorted[Index].Offset - MeanOffset);
+			Variance += DeltaTime * DeltaTime;
+		}
+		Drift = (Variance > 0.0) ? FMath::Clamp(Covariance / Variance, -MaxDrift, MaxDrift) : 0.0;
+	}
+
+	Estimate.Offset = MeanOffset;
+	Estimate.Drift = Drift;
+	Estimate.ReferenceTime = MeanTime;
+	Estimate.RoundTrip = Sorted[0].RoundTrip;
+	Estimate.NumSamples = NumSamples;
+}
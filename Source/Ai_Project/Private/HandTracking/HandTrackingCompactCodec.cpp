@@ -0,0 +1,444 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingCompactCodec.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Hand tracking compact frames are little-endian.");
+
+namespace HandTrackingCompactCodec
+{
+	namespace
+	{
+		// varint 하나가 담는 최대 바이트 수 (17비트)
+		constexpr int32 MaxVarintBytes = 3;
+
+		template <typename T>
+		FORCEINLINE T ReadValue(const uint8* Data)
+		{
+			T Value;
+			FMemory::Memcpy(&Value, Data, sizeof(T));
+			return Value;
+		}
+
+		template <typename T>
+		FORCEINLINE void WriteValue(uint8* Data, T Value)
+		{
+			FMemory::Memcpy(Data, &Value, sizeof(T));
+		}
+
+		FORCEINLINE uint32 ReadMask24(const uint8* Data)
+		{
+			return static_cast<uint32>(Data[0]) | (static_cast<uint32>(Data[1]) << 8) | (static_cast<uint32>(Data[2]) << 16);
+		}
+
+		FORCEINLINE void WriteMask24(uint8* Data, uint32 Mask)
+		{
+			Data[0] = static_cast<uint8>(Mask);
+			Data[1] = static_cast<uint8>(Mask >> 8);
+			Data[2] = static_cast<uint8>(Mask >> 16);
+		}
+
+		FORCEINLINE float GetQuantizationScale(int32 FractionBits)
+		{
+			return static_cast<float>(1 << FMath::Clamp(FractionBits, 0, MaxFractionBits));
+		}
+
+		FORCEINLINE int16 QuantizeValue(float Value, float Scale)
+		{
+			return static_cast<int16>(FMath::Clamp(FMath::RoundToInt32(Value * Scale), static_cast<int32>(MIN_int16), static_cast<int32>(MAX_int16)));
+		}
+
+		FORCEINLINE uint8 QuantizeConfidence(float Confidence)
+		{
+			return static_cast<uint8>(FMath::RoundToInt32(FMath::Clamp(Confidence, 0.0f, 1.0f) * MAX_uint8));
+		}
+
+		// 부호 있는 작은 수가 작은 부호 없는 수가 되도록 바꾼다 (0, -1, 1, -2, ... -> 0, 1, 2, 3, ...).
+		FORCEINLINE uint32 ZigZagEncode(int32 Value)
+		{
+			return (static_cast<uint32>(Value) << 1) ^ static_cast<uint32>(Value >> 31);
+		}
+
+		FORCEINLINE int32 ZigZagDecode(uint32 Value)
+		{
+			return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1);
+		}
+
+		void WriteVarint(TArray<uint8>& OutBytes, uint32 Value)
+		{
+			while (Value >= 0x80)
+			{
+				OutBytes.Add(static_cast<uint8>(Value | 0x80));
+				Value >>= 7;
+			}
+			OutBytes.Add(static_cast<uint8>(Value));
+		}
+
+		bool ReadVarint(const uint8*& Cursor, const uint8* End, uint32& OutValue)
+		{
+			OutValue = 0;
+			for (int32 Index = 0; Index < MaxVarintBytes && Cursor < End; ++Index)
+			{
+				const uint8 Byte = *Cursor++;
+				OutValue |= static_cast<uint32>(Byte & 0x7F) << (7 * Index);
+				if ((Byte & 0x80) == 0)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void WriteHeader(uint8* Data, int32 FrameSize, bool bKeyframe, uint64 CaptureTimeUs, uint16 KeyframeId, int32 HandCount, int32 FractionBits)
+		{
+			WriteValue<uint32>(Data, static_cast<uint32>(FrameSize));
+			WriteValue<uint16>(Data + 4, Magic);
+			Data[6] = Version;
+			Data[7] = bKeyframe ? KeyframeFlag : 0;
+			WriteValue<uint64>(Data + 8, CaptureTimeUs);
+			WriteValue<uint16>(Data + 16, KeyframeId);
+			Data[18] = static_cast<uint8>(HandCount);
+			Data[19] = static_cast<uint8>(FractionBits);
+		}
+
+		uint64 ToCaptureTimeUs(double CaptureTimestamp)
+		{
+			return static_cast<uint64>(FMath::Max(CaptureTimestamp, 0.0) * 1.0e6);
+		}
+
+		int32 WriteKeyframe(const FQuantizedHand* Hands, int32 NumHands, uint64 CaptureTimeUs, uint16 KeyframeId, int32 FractionBits, TArray<uint8>& OutBytes)
+		{
+			const int32 FrameSize = HeaderSize + NumHands * KeyframeHandSize;
+			const int32 StartOffset = OutBytes.AddUninitialized(FrameSize);
+			uint8* Data = OutBytes.GetData() + StartOffset;
+			WriteHeader(Data, FrameSize, true, CaptureTimeUs, KeyframeId, NumHands, FractionBits);
+
+			// 성분별 배열을 그대로 복사한다.
+			uint8* HandData = Data + HeaderSize;
+			for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex, HandData += KeyframeHandSize)
+			{
+				const FQuantizedHand& Hand = Hands[HandIndex];
+				HandData[0] = static_cast<uint8>(Hand.Handedness);
+				WriteMask24(HandData + 1, Hand.ValidMask);
+				FMemory::Memcpy(HandData + 4, Hand.X, sizeof(Hand.X));
+				FMemory::Memcpy(HandData + 4 + sizeof(Hand.X), Hand.Y, sizeof(Hand.Y));
+				FMemory::Memcpy(HandData + 4 + sizeof(Hand.X) + sizeof(Hand.Y), Hand.Z, sizeof(Hand.Z));
+				FMemory::Memcpy(HandData + 4 + sizeof(Hand.X) + sizeof(Hand.Y) + sizeof(Hand.Z), Hand.Confidence, sizeof(Hand.Confidence));
+			}
+			return FrameSize;
+		}
+
+		bool ReadKeyframeHands(const uint8* Data, int32 FrameSize, FQuantizedHand* OutHands, int32& OutNumHands)
+		{
+			OutNumHands = Data[18];
+			if (OutNumHands > MaxTrackedHands || FrameSize != HeaderSize + OutNumHands * KeyframeHandSize)
+			{
+				return false;
+			}
+
+			const uint8* HandData = Data + HeaderSize;
+			for (int32 HandIndex = 0; HandIndex < OutNumHands; ++HandIndex, HandData += KeyframeHandSize)
+			{
+				// 델타가 손을 순서로 가리키므로 잘못된 손은 건너뛰지 않고 프레임 전체를 버린다.
+				if (HandData[0] > static_cast<uint8>(EHandedness::Right))
+				{
+					return false;
+				}
+
+				FQuantizedHand& Hand = OutHands[HandIndex];
+				Hand.Handedness = static_cast<EHandedness>(HandData[0]);
+				Hand.ValidMask = ReadMask24(HandData + 1) & FHandFrame::AllLandmarksMask;
+				FMemory::Memcpy(Hand.X, HandData + 4, sizeof(Hand.X));
+				FMemory::Memcpy(Hand.Y, HandData + 4 + sizeof(Hand.X), sizeof(Hand.Y));
+				FMemory::Memcpy(Hand.Z, HandData + 4 + sizeof(Hand.X) + sizeof(Hand.Y), sizeof(Hand.Z));
+				FMemory::Memcpy(Hand.Confidence, HandData + 4 + sizeof(Hand.X) + sizeof(Hand.Y) + sizeof(Hand.Z), sizeof(Hand.Confidence));
+			}
+			return true;
+		}
+
+		bool ApplyDelta(const uint8* Cursor, const uint8* End, FQuantizedHand* Hands, int32 NumHands)
+		{
+			for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+			{
+				FQuantizedHand& Hand = Hands[HandIndex];
+				if (End - Cursor < 4 || Cursor[0] != static_cast<uint8>(Hand.Handedness))
+				{
+					return false;
+				}
+
+				const uint32 ChangedMask = ReadMask24(Cursor + 1);
+				Cursor += 4;
+				if ((ChangedMask & ~Hand.ValidMask) != 0)
+				{
+					return false;
+				}
+
+				int16* Components[3] = { Hand.X, Hand.Y, Hand.Z };
+				for (int16* Component : Components)
+				{
+					for (uint32 Bits = ChangedMask; Bits != 0; Bits &= Bits - 1)
+					{
+						const int32 Id = static_cast<int32>(FMath::CountTrailingZeros(Bits));
+						uint32 Encoded = 0;
+						if (!ReadVarint(Cursor, End, Encoded))
+						{
+							return false;
+						}
+
+						const int32 Value = Component[Id] + ZigZagDecode(Encoded);
+						if (Value < MIN_int16 || Value > MAX_int16)
+						{
+							return false;
+						}
+						Component[Id] = static_cast<int16>(Value);
+					}
+				}
+
+				// 신뢰도는 차이가 아니라 값 그대로 온다.
+				for (uint32 Bits = ChangedMask; Bits != 0; Bits &= Bits - 1)
+				{
+					if (Cursor >= End)
+					{
+						return false;
+					}
+					Hand.Confidence[FMath::CountTrailingZeros(Bits)] = *Cursor++;
+				}
+			}
+			return Cursor == End;
+		}
+	}
+
+	void Quantize(const FHandFrame& Hand, int32 FractionBits, FQuantizedHand& OutHand)
+	{
+		const float Scale = GetQuantizationScale(FractionBits);
+		OutHand.Handedness = Hand.Handedness;
+		OutHand.ValidMask = Hand.ValidMask & FHandFrame::AllLandmarksMask;
+		for (int32 Id = 0; Id < HandLandmarkCount; ++Id)
+		{
+			OutHand.X[Id] = QuantizeValue(Hand.X[Id], Scale);
+			OutHand.Y[Id] = QuantizeValue(Hand.Y[Id], Scale);
+			OutHand.Z[Id] = QuantizeValue(Hand.Z[Id], Scale);
+			OutHand.Confidence[Id] = QuantizeConfidence(Hand.Confidence[Id]);
+		}
+	}
+
+	bool ReadHeader(const uint8* Data, int32 Size, int32& OutFrameSize, bool& bOutKeyframe, uint16& OutKeyframeId)
+	{
+		if (Data == nullptr || Size < HeaderSize)
+		{
+			return false;
+		}
+
+		const uint32 FrameSize = ReadValue<uint32>(Data);
+		if (ReadValue<uint16>(Data + 4) != Magic || Data[6] != Version || Data[19] > MaxFractionBits
+			|| FrameSize < static_cast<uint32>(HeaderSize) || FrameSize > static_cast<uint32>(MaxFrameSize) || FrameSize > static_cast<uint32>(Size))
+		{
+			return false;
+		}
+
+		OutFrameSize = static_cast<int32>(FrameSize);
+		bOutKeyframe = (Data[7] & KeyframeFlag) != 0;
+		OutKeyframeId = ReadValue<uint16>(Data + 16);
+		return true;
+	}
+
+	int32 EncodeKeyframe(const FHandTrackingFrame& Frame, uint16 KeyframeId, int32 FractionBits, TArray<uint8>& OutBytes)
+	{
+		FractionBits = FMath::Clamp(FractionBits, 0, MaxFractionBits);
+		const int32 NumHands = FMath::Clamp(Frame.NumHands, 0, MaxTrackedHands);
+		FQuantizedHand Hands[MaxTrackedHands];
+		for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+		{
+			Quantize(Frame.Hands[HandIndex], FractionBits, Hands[HandIndex]);
+		}
+		return WriteKeyframe(Hands, NumHands, ToCaptureTimeUs(Frame.CaptureTimestamp), KeyframeId, FractionBits, OutBytes);
+	}
+
+	bool DecodeFrame(const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame)
+	{
+		int32 KeyframeSize = 0;
+		bool bKeyframe = false;
+		uint16 KeyframeId = 0;
+		if (!ReadHeader(Data, Size, KeyframeSize, bKeyframe, KeyframeId) || !bKeyframe)
+		{
+			return false;
+		}
+
+		FQuantizedHand Hands[MaxTrackedHands];
+		int32 NumHands = 0;
+		if (!ReadKeyframeHands(Data, KeyframeSize, Hands, NumHands))
+		{
+			return false;
+		}
+
+		uint64 CaptureTimeUs = ReadValue<uint64>(Data + 8);
+		if (Size > KeyframeSize)
+		{
+			const uint8* Delta = Data + KeyframeSize;
+			int32 DeltaSize = 0;
+			bool bDeltaIsKeyframe = false;
+			uint16 BaseKeyframeId = 0;
+			if (!ReadHeader(Delta, Size - KeyframeSize, DeltaSize, bDeltaIsKeyframe, BaseKeyframeId)
+				|| bDeltaIsKeyframe || BaseKeyframeId != KeyframeId || Delta[18] != NumHands || Delta[19] != Data[19]
+				|| !ApplyDelta(Delta + HeaderSize, Delta + DeltaSize, Hands, NumHands))
+			{
+				return false;
+			}
+			CaptureTimeUs = ReadValue<uint64>(Delta + 8);
+		}
+
+		const float InverseScale = 1.0f / GetQuantizationScale(Data[19]);
+		constexpr float InverseConfidenceScale = 1.0f / MAX_uint8;
+		OutFrame.CaptureTimestamp = static_cast<double>(CaptureTimeUs) * 1.0e-6;
+		OutFrame.NumHands = NumHands;
+		for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+		{
+			const FQuantizedHand& Quantized = Hands[HandIndex];
+			FHandFrame& Hand = OutFrame.Hands[HandIndex];
+			Hand.Reset(Quantized.Handedness);
+			Hand.ValidMask = Quantized.ValidMask;
+			for (uint32 Bits = Quantized.ValidMask; Bits != 0; Bits &= Bits - 1)
+			{
+				const int32 Id = static_cast<int32>(FMath::CountTrailingZeros(Bits));
+				Hand.X[Id] = Quantized.X[Id] * InverseScale;
+				Hand.Y[Id] = Quantized.Y[Id] * InverseScale;
+				Hand.Z[Id] = Quantized.Z[Id] * InverseScale;
+				Hand.Confidence[Id] = Quantized.Confidence[Id] * InverseConfidenceScale;
+			}
+		}
+		return true;
+	}
+}
+
+FHandTrackingCompactEncoder::FHandTrackingCompactEncoder(const FHandTrackingCompactEncoderSettings& InSettings)
+	: Settings(InSettings)
+{
+	Settings.KeyframeInterval = FMath::Max(Settings.KeyframeInterval, 1);
+	Settings.FractionBits = FMath::Clamp(Settings.FractionBits, 0, HandTrackingCompactCodec::MaxFractionBits);
+	ThresholdQuanta = FMath::Max(FMath::FloorToInt32(Settings.DeltaThreshold * HandTrackingCompactCodec::GetQuantizationScale(Settings.FractionBits)), 0);
+	ConfidenceThresholdQuanta = FMath::Max(FMath::FloorToInt32(Settings.ConfidenceThreshold * MAX_uint8), 0);
+}
+
+int32 FHandTrackingCompactEncoder::Encode(const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes)
+{
+	using namespace HandTrackingCompactCodec;
+
+	const int32 NumHands = FMath::Clamp(Frame.NumHands, 0, MaxTrackedHands);
+	FQuantizedHand Hands[MaxTrackedHands];
+	for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+	{
+		Quantize(Frame.Hands[HandIndex], Settings.FractionBits, Hands[HandIndex]);
+	}
+
+	const uint64 CaptureTimeUs = ToCaptureTimeUs(Frame.CaptureTimestamp);
+	if (!bHasKeyframe || FramesSinceKeyframe + 1 >= Settings.KeyframeInterval || !MatchesKeyframe(Hands, NumHands))
+	{
+		++KeyframeId;
+		for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+		{
+			KeyframeHands[HandIndex] = Hands[HandIndex];
+		}
+		NumKeyframeHands = NumHands;
+		FramesSinceKeyframe = 0;
+		bHasKeyframe = true;
+		return WriteKeyframe(Hands, NumHands, CaptureTimeUs, KeyframeId, Settings.FractionBits, OutBytes);
+	}
+
+	++FramesSinceKeyframe;
+	const int32 StartOffset = OutBytes.AddUninitialized(HeaderSize);
+	for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+	{
+		const FQuantizedHand& Hand = Hands[HandIndex];
+		const FQuantizedHand& Key = KeyframeHands[HandIndex];
+
+		uint32 ChangedMask = 0;
+		for (uint32 Bits = Hand.ValidMask; Bits != 0; Bits &= Bits - 1)
+		{
+			const int32 Id = static_cast<int32>(FMath::CountTrailingZeros(Bits));
+			const int32 MaxMove = FMath::Max3(FMath::Abs(Hand.X[Id] - Key.X[Id]), FMath::Abs(Hand.Y[Id] - Key.Y[Id]), FMath::Abs(Hand.Z[Id] - Key.Z[Id]));
+			const int32 ConfidenceChange = FMath::Abs(Hand.Confidence[Id] - Key.Confidence[Id]);
+			ChangedMask |= (MaxMove > ThresholdQuanta || ConfidenceChange > ConfidenceThresholdQuanta) ? (1u << Id) : 0u;
+		}
+
+		const int32 HandOffset = OutBytes.AddUninitialized(4);
+		OutBytes[HandOffset] = static_cast<uint8>(Hand.Handedness);
+		WriteMask24(OutBytes.GetData() + HandOffset + 1, ChangedMask);
+
+		const int16* NewComponents[3] = { Hand.X, Hand.Y, Hand.Z };
+		const int16* KeyComponents[3] = { Key.X, Key.Y, Key.Z };
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			for (uint32 Bits = ChangedMask; Bits != 0; Bits &= Bits - 1)
+			{
+				const int32 Id = static_cast<int32>(FMath::CountTrailingZeros(Bits));
+				WriteVarint(OutBytes, ZigZagEncode(NewComponents[Axis][Id] - KeyComponents[Axis][Id]));
+			}
+		}
+		for (uint32 Bits = ChangedMask; Bits != 0; Bits &= Bits - 1)
+		{
+			OutBytes.Add(Hand.Confidence[FMath::CountTrailingZeros(Bits)]);
+		}
+	}
+
+	const int32 FrameSize = OutBytes.Num() - StartOffset;
+	WriteHeader(OutBytes.GetData() + StartOffset, FrameSize, false, CaptureTimeUs, KeyframeId, NumHands, Settings.FractionBits);
+	return FrameSize;
+}
+
+bool FHandTrackingCompactEncoder::MatchesKeyframe(const HandTrackingCompactCodec::FQuantizedHand* Hands, int32 NumHands) const
+{
+	if (NumHands != NumKeyframeHands)
+	{
+		return false;
+	}
+	for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+	{
+		if (Hands[HandIndex].Handedness != KeyframeHands[HandIndex].Handedness || Hands[HandIndex].ValidMask != KeyframeHands[HandIndex].ValidMask)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FHandTrackingCompactKeyframeCache::Observe(const uint8* Data, int32 Size)
+{
+	int32 FrameSize = 0;
+	bool bKeyframe = false;
+	uint16 Id = 0;
+	if (HandTrackingCompactCodec::ReadHeader(Data, Size, FrameSize, bKeyframe, Id) && bKeyframe)
+	{
+		Keyframe.Reset();
+		Keyframe.Append(Data, FrameSize);
+		KeyframeId = Id;
+	}
+}
+
+bool FHandTrackingCompactKeyframeCache::Resolve(const uint8* Data, int32 Size, TArray<uint8>& OutFrame) const
+{
+	int32 FrameSize = 0;
+	bool bKeyframe = false;
+	uint16 Id = 0;
+	if (!HandTrackingCompactCodec::ReadHeader(Data, Size, FrameSize, bKeyframe, Id))
+	{
+		return false;
+	}
+
+	if (!bKeyframe)
+	{
+		// 기준 키프레임을 아직 못 받았으면 다음 키프레임까지 버린다.
+		if (Keyframe.Num() == 0 || Id != KeyframeId)
+		{
+			return false;
+		}
+		OutFrame.Append(Keyframe);
+	}
+	OutFrame.Append(Data, FrameSize);
+	return true;
+}
+
+void FHandTrackingCompactKeyframeCache::Reset()
+{
+	Keyframe.Reset();
+	KeyframeId = 0;
+}
@@ -0,0 +1,208 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingFingerSolver.h"
+
+namespace
+{
+	constexpr int32 LandmarksPerFinger = 4;
+	constexpr int32 NumChains = MaxTrackedHands * FHandTrackingHandPose::NumFingers;
+	constexpr int32 NumLanes = Align(NumChains, 4);
+	constexpr float MinSegmentLength = 1.0e-4f;
+
+	// 체인 하나가 SIMD 레인 하나. 성분별로 레인 수만큼 나열한다.
+	struct FChainBatch
+	{
+		// 손가락 랜드마크 4개 (뿌리 -> 끝)
+		float PX[LandmarksPerFinger][NumLanes];
+		float PY[LandmarksPerFinger][NumLanes];
+		float PZ[LandmarksPerFinger][NumLanes];
+		// 이 체인이 속한 손의 손바닥 축
+		float Axis[3][3][NumLanes];
+
+		float Spread[NumLanes];
+		float Flex[3][NumLanes];
+	};
+
+	struct FVec3Register
+	{
+		VectorRegister4Float X, Y, Z;
+	};
+
+	FORCEINLINE VectorRegister4Float Dot(const FVec3Register& A, const FVec3Register& B)
+	{
+		return VectorMultiplyAdd(A.X, B.X, VectorMultiplyAdd(A.Y, B.Y, VectorMultiply(A.Z, B.Z)));
+	}
+
+	FORCEINLINE FVec3Register Sub(const FVec3Register& A, const FVec3Register& B)
+	{
+		return { VectorSubtract(A.X, B.X), VectorSubtract(A.Y, B.Y), VectorSubtract(A.Z, B.Z) };
+	}
+
+	FORCEINLINE VectorRegister4Float Length2D(const VectorRegister4Float& U, const VectorRegister4Float& W)
+	{
+		return VectorSqrt(VectorMultiplyAdd(U, U, VectorMultiply(W, W)));
+	}
+
+	FORCEINLINE VectorRegister4Float ClampUnit(const VectorRegister4Float& Value)
+	{
+		return VectorMax(VectorMin(Value, VectorSetFloat1(1.0f)), VectorSetFloat1(-1.0f));
+	}
+
+	void SolveLanes(FChainBatch& Batch, int32 Lane)
+	{
+		auto LoadPoint = [&Batch, Lane](int32 Index) -> FVec3Register
+		{
+			return { VectorLoad(Batch.PX[Index] + Lane), VectorLoad(Batch.PY[Index] + Lane), VectorLoad(Batch.PZ[Index] + Lane) };
+		};
+		auto LoadAxis = [&Batch, Lane](int32 Index) -> FVec3Register
+		{
+			return { VectorLoad(Batch.Axis[Index][0] + Lane), VectorLoad(Batch.Axis[Index][1] + Lane), VectorLoad(Batch.Axis[Index][2] + Lane) };
+		};
+
+		const VectorRegister4Float Epsilon = VectorSetFloat1(MinSegmentLength);
+		const VectorRegister4Float Two = VectorSetFloat1(2.0f);
+
+		const FVec3Register P0 = LoadPoint(0);
+		const FVec3Register P1 = LoadPoint(1);
+		const FVec3Register P2 = LoadPoint(2);
+		const FVec3Register P3 = LoadPoint(3);
+		const FVec3Register AxisX = LoadAxis(0);
+		const FVec3Register AxisY = LoadAxis(1);
+		const FVec3Register AxisZ = LoadAxis(2);
+
+		// 뿌리 마디: 손바닥 좌표계에서 벌어진 각도와 굽힘을 바로 읽는다.
+		const FVec3Register Base = Sub(P1, P0);
+		const VectorRegister4Float BaseX = Dot(Base, AxisX);
+		const VectorRegister4Float BaseY = Dot(Base, AxisY);
+		const VectorRegister4Float BaseZ = Dot(Base, AxisZ);
+		const VectorRegister4Float Spread = VectorATan2(BaseY, BaseX);
+		const VectorRegister4Float BaseInPlane = VectorMax(Length2D(BaseX, BaseY), Epsilon);
+		const VectorRegister4Float Flex0 = VectorATan2(VectorNegate(BaseZ), BaseInPlane);
+
+		// 손가락 평면: u는 손바닥 평면 위 손가락 방향, w는 -Z
+		const VectorRegister4Float CosSpread = VectorDivide(BaseX, BaseInPlane);
+		const VectorRegister4Float SinSpread = VectorDivide(BaseY, BaseInPlane);
+		auto ToPlane = [&](const FVec3Register& V, VectorRegister4Float& OutU, VectorRegister4Float& OutW)
+		{
+			OutU = VectorMultiplyAdd(CosSpread, Dot(V, AxisX), VectorMultiply(SinSpread, Dot(V, AxisY)));
+			OutW = VectorNegate(Dot(V, AxisZ));
+		};
+
+		VectorRegister4Float MiddleU, MiddleW, ChordU, ChordW;
+		ToPlane(Sub(P2, P1), MiddleU, MiddleW);
+		ToPlane(Sub(P3, P1), ChordU, ChordW);
+
+		// 2본 IK: 가운데 마디 길이 A, 끝 마디 길이 B, 현 길이 D
+		const VectorRegister4Float A = VectorMax(Length2D(MiddleU, MiddleW), Epsilon);
+		const VectorRegister4Float B = VectorMax(Length2D(VectorSubtract(ChordU, MiddleU), VectorSubtract(ChordW, MiddleW)), Epsilon);
+		const VectorRegister4Float MinReach = VectorMax(VectorAbs(VectorSubtract(A, B)), Epsilon);
+		const VectorRegister4Float D = VectorMax(VectorMin(Length2D(ChordU, ChordW), VectorAdd(A, B)), MinReach);
+
+		const VectorRegister4Float AA = VectorMultiply(A, A);
+		const VectorRegister4Float BB = VectorMultiply(B, B);
+		const VectorRegister4Float DD = VectorMultiply(D, D);
+		// 현과 가운데 마디 사이 각, 가운데 관절의 안쪽 각
+		const VectorRegister4Float Alpha = VectorACos(ClampUnit(VectorDivide(VectorSubtract(VectorAdd(AA, DD), BB), VectorMultiply(Two, VectorMultiply(A, D)))));
+		const VectorRegister4Float Inner = VectorACos(ClampUnit(VectorDivide(VectorSubtract(VectorAdd(AA, BB), DD), VectorMultiply(Two, VectorMultiply(A, B)))));
+		const VectorRegister4Float Bend = VectorSubtract(VectorSetFloat1(UE_PI), Inner);
+
+		// 가운데 관절이 현보다 아래(-w)에 있으면 현 각도보다 덜 굽고 끝 마디가 더 굽는다.
+		const VectorRegister4Float Side = VectorSubtract(VectorMultiply(ChordU, MiddleW), VectorMultiply(ChordW, MiddleU));
+		const VectorRegister4Float bBelow = VectorCompareLT(Side, VectorZeroFloat());
+		const VectorRegister4Float ChordAngle = VectorATan2(ChordW, ChordU);
+		const VectorRegister4Float MiddleAngle = VectorSelect(bBelow, VectorSubtract(ChordAngle, Alpha), VectorAdd(ChordAngle, Alpha));
+
+		VectorStore(Spread, Batch.Spread + Lane);
+		VectorStore(Flex0, Batch.Flex[0] + Lane);
+		VectorStore(VectorSubtract(MiddleAngle, Flex0), Batch.Flex[1] + Lane);
+		VectorStore(VectorSelect(bBelow, Bend, VectorNegate(Bend)), Batch.Flex[2] + Lane);
+	}
+}
+
+bool HandTrackingFingerSolver::ComputePalmAxes(const FVector3f& Wrist, const FVector3f& IndexBase, const FVector3f& MiddleBase, const FVector3f& PinkyBase,
+	FVector3f& OutX, FVector3f& OutY, FVector3f& OutZ)
+{
+	OutX = (MiddleBase - Wrist).GetSafeNormal();
+	OutZ = (OutX ^ (IndexBase - PinkyBase)).GetSafeNormal();
+	if (OutX.IsZero() || OutZ.IsZero())
+	{
+		return false;
+	}
+	OutY = OutZ ^ OutX;
+	return true;
+}
+
+void HandTrackingFingerSolver::Solve(const FHandFrame* Hands, int32 NumHands, float MinConfidence, FHandTrackingHandPose* OutPoses)
+{
+	check(NumHands <= MaxTrackedHands);
+
+	FChainBatch Batch;
+	FMemory::Memzero(Batch);
+
+	auto IsUsable = [MinConfidence](const FHandFrame& Hand, int32 LandmarkId)
+	{
+		return Hand.IsLandmarkValid(LandmarkId) && Hand.Confidence[LandmarkId] >= MinConfidence;
+	};
+
+	// 손바닥 축을 구하고 손가락 체인을 레인에 채운다.
+	for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+	{
+		const FHandFrame& Hand = Hands[HandIndex];
+		FHandTrackingHandPose& Pose = OutPoses[HandIndex];
+		Pose.ValidFingerMask = 0;
+		Pose.bPalmValid = false;
+
+		FVector3f Axes[3];
+		if (!IsUsable(Hand, 0) || !IsUsable(Hand, 5) || !IsUsable(Hand, 9) || !IsUsable(Hand, 17)
+			|| !ComputePalmAxes(Hand.GetPosition(0), Hand.GetPosition(5), Hand.GetPosition(9), Hand.GetPosition(17), Axes[0], Axes[1], Axes[2]))
+		{
+			continue;
+		}
+		Pose.bPalmValid = true;
+		Pose.PalmRotation = FMatrix44f(Axes[0], Axes[1], Axes[2], FVector3f::ZeroVector).ToQuat();
+
+		for (int32 Finger = 0; Finger < FHandTrackingHandPose::NumFingers; ++Finger)
+		{
+			const int32 FirstLandmark = 1 + Finger * LandmarksPerFinger;
+			const int32 Lane = HandIndex * FHandTrackingHandPose::NumFingers + Finger;
+
+			bool bUsable = true;
+			for (int32 Joint = 0; Joint < LandmarksPerFinger; ++Joint)
+			{
+				const int32 LandmarkId = FirstLandmark + Joint;
+				bUsable &= IsUsable(Hand, LandmarkId);
+				Batch.PX[Joint][Lane] = Hand.X[LandmarkId];
+				Batch.PY[Joint][Lane] = Hand.Y[LandmarkId];
+				Batch.PZ[Joint][Lane] = Hand.Z[LandmarkId];
+			}
+			for (int32 AxisIndex = 0; AxisIndex < 3; ++AxisIndex)
+			{
+				Batch.Axis[AxisIndex][0][Lane] = Axes[AxisIndex].X;
+				Batch.Axis[AxisIndex][1][Lane] = Axes[AxisIndex].Y;
+				Batch.Axis[AxisIndex][2][Lane] = Axes[AxisIndex].Z;
+			}
+			Pose.ValidFingerMask |= bUsable ? (1u << Finger) : 0u;
+		}
+	}
+
+	// 모든 손의 체인을 4개씩 한꺼번에 푼다. 빈 레인은 0이라 결과만 버린다.
+	for (int32 Lane = 0; Lane < NumLanes; Lane += 4)
+	{
+		SolveLanes(Batch, Lane);
+	}
+
+	for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+	{
+		FHandTrackingHandPose& Pose = OutPoses[HandIndex];
+		for (int32 Finger = 0; Finger < FHandTrackingHandPose::NumFingers; ++Finger)
+		{
+			const int32 Lane = HandIndex * FHandTrackingHandPose::NumFingers + Finger;
+			FHandTrackingFingerPose& FingerPose = Pose.Fingers[Finger];
+			FingerPose.Spread = Batch.Spread[Lane];
+			FingerPose.Flex[0] = Batch.Flex[0][Lane];
+			FingerPose.Flex[1] = Batch.Flex[1][Lane];
+			FingerPose.Flex[2] = Batch.Flex[2][Lane];
+		}
+	}
+}
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingFrameQueue.h"
+
+#include "HandTracking/HandTrackingRecorder.h"
+
+void FHandTrackingFrameQueue::Publish(const uint8* Data, int32 Size)
+{
+	if (Recorder.IsValid())
+	{
+		Recorder->RecordFrame(Data, Size);
+	}
+
+	// 아직 링에 넣지 못한 프레임이 있다면 더 새로운 프레임으로 덮어쓴다.
+	if (bHasPendingFrame.load(std::memory_order_relaxed))
+	{
+		DroppedFrameCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	PendingFrame.Data.Reset();
+	PendingFrame.Data.Append(Data, Size);
+	PendingFrame.ArrivalTime = FPlatformTime::Seconds();
+	bHasPendingFrame.store(true, std::memory_order_relaxed);
+
+	FlushPending();
+}
+
+void FHandTrackingFrameQueue::FlushPending()
+{
+	if (bHasPendingFrame.load(std::memory_order_relaxed) && FrameRing.TryPush(PendingFrame))
+	{
+		bHasPendingFrame.store(false, std::memory_order_release);
+	}
+}
+
+bool FHandTrackingFrameQueue::PopLatest(FHandTrackingRawFrame& OutFrame)
+{
+	uint32 SkippedCount = 0;
+	if (FrameRing.PopLatest(OutFrame, &SkippedCount))
+	{
+		DroppedFrameCount.fetch_add(SkippedCount, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingIoThread.h"
+
+#include "HAL/Event.h"
+#include "HAL/RunnableThread.h"
+#include "HandTracking/HandTrackingReceiveWorker.h"
+#include "HandTracking/HandTrackingStats.h"
+
+namespace
+{
+	// 아무 소켓에도 할 일이 없었을 때 다음 바퀴까지 쉬는 시간
+	constexpr uint32 IdleWaitMs = 1;
+
+	FCriticalSection InstanceLock;
+	TWeakPtr<FHandTrackingIoThread, ESPMode::ThreadSafe> Instance;
+}
+
+TSharedPtr<FHandTrackingIoThread, ESPMode::ThreadSafe> FHandTrackingIoThread::Acquire()
+{
+	FScopeLock Lock(&InstanceLock);
+	if (TSharedPtr<FHandTrackingIoThread, ESPMode::ThreadSafe> Existing = Instance.Pin())
+	{
+		return Existing;
+	}
+
+	TSharedRef<FHandTrackingIoThread, ESPMode::ThreadSafe> NewInstance = MakeShareable(new FHandTrackingIoThread());
+	if (!NewInstance->Start())
+	{
+		// 돌지 않는 스레드를 캐시해 두면 이후 워커가 모두 아무 데이터도 받지 못하므로 다음 Acquire에서 다시 띄운다.
+		UE_LOG(LogHandTracking, Error, TEXT("Failed to start hand tracking I/O thread."));
+		return nullptr;
+	}
+	Instance = NewInstance;
+	return NewInstance;
+}
+
+FHandTrackingIoThread::FHandTrackingIoThread()
+{
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FHandTrackingIoThread::~FHandTrackingIoThread()
+{
+	if (Thread)
+	{
+		// Kill(true)가 Stop()을 호출하고 Run()이 끝날 때까지 기다린다.
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+bool FHandTrackingIoThread::Start()
+{
+	Thread = FRunnableThread::Create(this, TEXT("HandTrackingIO"), 0, TPri_AboveNormal);
+	return Thread != nullptr;
+}
+
+void FHandTrackingIoThread::Register(FHandTrackingReceiveWorker* Worker)
+{
+	{
+		FScopeLock Lock(&WorkersLock);
+		Workers.AddUnique(Worker);
+	}
+	Wake();
+}
+
+void FHandTrackingIoThread::Unregister(FHandTrackingReceiveWorker* Worker)
+{
+	// 바퀴 하나가 끝날 때까지 기다렸다가 뺀다.
+	FScopeLock Lock(&WorkersLock);
+	Workers.Remove(Worker);
+}
+
+void FHandTrackingIoThread::Wake()
+{
+	WakeEvent->Trigger();
+}
+
+int32 FHandTrackingIoThread::GetNumWorkers() const
+{
+	FScopeLock Lock(&WorkersLock);
+	return Workers.Num();
+}
+
+uint32 FHandTrackingIoThread::Run()
+{
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		bool bDidWork = false;
+		{
+			FScopeLock Lock(&WorkersLock);
+			const double Now = FPlatformTime::Seconds();
+			for (FHandTrackingReceiveWorker* Worker : Workers)
+			{
+				bDidWork |= Worker->Service(Now);
+			}
+		}
+
+		if (!bDidWork)
+		{
+			WakeEvent->Wait(IdleWaitMs);
+		}
+	}
+	return 0;
+}
+
+void FHandTrackingIoThread::Stop()
+{
+	bStopRequested = true;
+	WakeEvent->Trigger();
+}
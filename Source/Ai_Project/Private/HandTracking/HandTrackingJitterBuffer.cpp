@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingJitterBuffer.h"
+
+namespace
+{
+	// A + (B - A) * Alpha. 랜드마크 4개씩
+	void LerpComponent(const float* A, const float* B, const VectorRegister4Float& Alpha, float* Out)
+	{
+		for (int32 Base = 0; Base < FHandFrame::PaddedLandmarkCount; Base += 4)
+		{
+			const VectorRegister4Float From = VectorLoad(A + Base);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(VectorLoad(B + Base), From), Alpha, From), Out + Base);
+		}
+	}
+}
+
+void FHandTrackingJitterBuffer::Push(const FHandFrame& Hand, double CaptureTime)
+{
+	if (bHasPlayedOut && CaptureTime <= LastPlayoutTime)
+	{
+		if (LastPlayoutTime - CaptureTime < RestartThreshold)
+		{
+			// 재생 시각을 이미 지나 보간에 쓸 수 없다.
+			++LateFrames;
+			return;
+		}
+		Reset();
+	}
+
+	// 대부분 순서대로 오므로 뒤에서부터 자리를 찾는다. 같은 시각이면 새 값으로 덮어쓴다.
+	int32 Index = NumFrames;
+	while (Index > 0 && Times[GetSlot(Index - 1)] > CaptureTime)
+	{
+		--Index;
+	}
+	if (Index > 0 && Times[GetSlot(Index - 1)] == CaptureTime)
+	{
+		Frames[GetSlot(Index - 1)] = Hand;
+		return;
+	}
+
+	if (NumFrames == Capacity)
+	{
+		// 가득 찼으면 가장 오래된 프레임을 버린다. 새 프레임이 그보다 오래됐으면 새 프레임을 버린다.
+		++Overflows;
+		if (Index == 0)
+		{
+			return;
+		}
+		Head = GetSlot(1);
+		--NumFrames;
+		--Index;
+	}
+
+	for (int32 Move = NumFrames; Move > Index; --Move)
+	{
+		Frames[GetSlot(Move)] = Frames[GetSlot(Move - 1)];
+		Times[GetSlot(Move)] = Times[GetSlot(Move - 1)];
+	}
+	Frames[GetSlot(Index)] = Hand;
+	Times[GetSlot(Index)] = CaptureTime;
+	++NumFrames;
+}
+
+FHandTrackingJitterBuffer::ESampleResult FHandTrackingJitterBuffer::Sample(double PlayoutTime, FHandFrame& OutHand)
+{
+	if (NumFrames == 0)
+	{
+		return ESampleResult::Empty;
+	}
+
+	// 재생 시각 앞쪽의 프레임은 하나만 남긴다.
+	while (NumFrames >= 2 && Times[GetSlot(1)] <= PlayoutTime)
+	{
+		Head = GetSlot(1);
+		--NumFrames;
+	}
+	LastPlayoutTime = PlayoutTime;
+	bHasPlayedOut = true;
+
+	const FHandFrame& From = Frames[Head];
+	const double FromTime = Times[Head];
+	if (PlayoutTime < FromTime)
+	{
+		OutHand = From;
+		return ESampleResult::BeforeOldest;
+	}
+	// 가장 새 프레임 시각과 딱 맞으면 그 프레임이 답이다. 위에서 앞 프레임을 버려 하나만 남았어도 모자란 것이 아니다.
+	if (NumFrames == 1 && PlayoutTime <= FromTime)
+	{
+		OutHand = From;
+		return ESampleResult::Interpolated;
+	}
+	if (NumFrames == 1)
+	{
+		++Underflows;
+		OutHand = From;
+		return ESampleResult::Underflow;
+	}
+
+	const FHandFrame& To = Frames[GetSlot(1)];
+	const double ToTime = Times[GetSlot(1)];
+	const VectorRegister4Float Alpha = VectorSetFloat1(static_cast<float>((PlayoutTime - FromTime) / (ToTime - FromTime)));
+	LerpComponent(From.X, To.X, Alpha, OutHand.X);
+	LerpComponent(From.Y, To.Y, Alpha, OutHand.Y);
+	LerpComponent(From.Z, To.Z, Alpha, OutHand.Z);
+	LerpComponent(From.Confidence, To.Confidence, Alpha, OutHand.Confidence);
+
+	// 한쪽에만 있는 랜드마크는 보간할 수 없으므로 둘 다 있는 것만 낸다. 겹치는 게 없으면 새 프레임을 그대로 쓴다.
+	OutHand.Handedness = To.Handedness;
+	OutHand.ValidMask = From.ValidMask & To.ValidMask;
+	if (OutHand.ValidMask == 0)
+	{
+		OutHand = To;
+	}
+	return ESampleResult::Interpolated;
+}
+
+FHandTrackingJitterBufferStats FHandTrackingJitterBuffer::GetStats() const
+{
+	FHandTrackingJitterBufferStats Stats;
+	Stats.BufferedFrames = NumFrames;
+	Stats.Underflows = Underflows;
+	Stats.Overflows = Overflows;
+	Stats.LateFrames = LateFrames;
+	return Stats;
+}
+
+void FHandTrackingJitterBuffer::Reset()
+{
+	Head = 0;
+	NumFrames = 0;
+	LastPlayoutTime = 0.0;
+	bHasPlayedOut = false;
+}
@@ -0,0 +1,557 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingJsonParser.h"
+
+namespace
+{
+	enum class EFrameKey : uint8
+	{
+		Unknown,
+		Hands,
+		Timestamp,
+		Type,
+		Landmarks,
+		Id,
+		X,
+		Y,
+		Z,
+	};
+
+	// 정확히 표현되는 10의 거듭제곱. 트래커 좌표는 대부분 이 범위 안에서 끝난다.
+	constexpr double ExactPowersOfTen[] =
+	{
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+		1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+	};
+
+	template <typename CharType>
+	class TFrameScanner
+	{
+	public:
+		TFrameScanner(const CharType* InText, int32 InLength)
+			: Cursor(InText)
+			, End(InText + InLength)
+		{
+		}
+
+		bool ParseFrame(FHandTrackingFrame& OutFrame)
+		{
+			OutFrame.Reset();
+
+			bool bHasHands = false;
+			if (!BeginObject())
+			{
+				return false;
+			}
+			for (bool bMore = !TryEnd('}'); bMore; bMore = NextMember('}'))
+			{
+				EFrameKey Key;
+				if (!ParseKey(Key))
+				{
+					return false;
+				}
+
+				bool bParsed;
+				switch (Key)
+				{
+				case EFrameKey::Hands:
+					bParsed = ParseHands(OutFrame);
+					bHasHands = true;
+					break;
+				case EFrameKey::Timestamp:
+					bParsed = ParseNumber(OutFrame.CaptureTimestamp);
+					break;
+				default:
+					bParsed = SkipValue();
+					break;
+				}
+				if (!bParsed)
+				{
+					return false;
+				}
+			}
+
+			// 뒤에 공백 외의 다른 것이 붙어 있으면 프레임 경계가 잘못된 것이다.
+			SkipWhitespace();
+			return !bError && bHasHands && Cursor == End;
+		}
+
+	private:
+		bool ParseHands(FHandTrackingFrame& OutFrame)
+		{
+			if (!Expect('['))
+			{
+				return false;
+			}
+			for (bool bMore = !TryEnd(']'); bMore; bMore = NextMember(']'))
+			{
+				// 담을 자리가 없는 손은 건너뛴다.
+				if (OutFrame.NumHands >= MaxTrackedHands)
+				{
+					if (!SkipValue())
+					{
+						return false;
+					}
+					continue;
+				}
+
+				bool bValidHand = false;
+				if (!ParseHand(OutFrame.Hands[OutFrame.NumHands], bValidHand))
+				{
+					return false;
+				}
+				if (bValidHand)
+				{
+					++OutFrame.NumHands;
+				}
+			}
+			return !bError;
+		}
+
+		bool ParseHand(FHandFrame& OutHand, bool& bOutValid)
+		{
+			if (!BeginObject())
+			{
+				return false;
+			}
+
+			OutHand.Reset(EHandedness::Right);
+
+			bool bHasHandedness = false;
+			bool bHasLandmarks = false;
+			for (bool bMore = !TryEnd('}'); bMore; bMore = NextMember('}'))
+			{
+				EFrameKey Key;
+				if (!ParseKey(Key))
+				{
+					return false;
+				}
+
+				bool bParsed;
+				switch (Key)
+				{
+				case EFrameKey::Type:
+					bParsed = ParseHandedness(OutHand.Handedness, bHasHandedness);
+					break;
+				case EFrameKey::Landmarks:
+					bParsed = ParseLandmarks(OutHand);
+					bHasLandmarks = true;
+					break;
+				default:
+					bParsed = SkipValue();
+					break;
+				}
+				if (!bParsed)
+				{
+					return false;
+				}
+			}
+
+			// 범용 파서와 마찬가지로 type이 Left/Right가 아니거나 landmarks가 없는 손은 버린다.
+			bOutValid = bHasHandedness && bHasLandmarks;
+			return !bError;
+		}
+
+		bool ParseLandmarks(FHandFrame& OutHand)
+		{
+			if (!Expect('['))
+			{
+				return false;
+			}
+			for (bool bMore = !TryEnd(']'); bMore; bMore = NextMember(']'))
+			{
+				if (!BeginObject())
+				{
+					return false;
+				}
+
+				double Id = -1.0;
+				double Position[3] = { 0.0, 0.0, 0.0 };
+				for (bool bMoreFields = !TryEnd('}'); bMoreFields; bMoreFields = NextMember('}'))
+				{
+					EFrameKey Key;
+					if (!ParseKey(Key))
+					{
+						return false;
+					}
+
+					bool bParsed;
+					switch (Key)
+					{
+					case EFrameKey::Id: bParsed = ParseNumber(Id); break;
+					case EFrameKey::X: bParsed = ParseNumber(Position[0]); break;
+					case EFrameKey::Y: bParsed = ParseNumber(Position[1]); break;
+					case EFrameKey::Z: bParsed = ParseNumber(Position[2]); break;
+					default: bParsed = SkipValue(); break;
+					}
+					if (!bParsed)
+					{
+						return false;
+					}
+				}
+				if (bError)
+				{
+					return false;
+				}
+
+				const int32 LandmarkId = static_cast<int32>(Id);
+				if (LandmarkId >= 0 && LandmarkId < HandLandmarkCount)
+				{
+					OutHand.SetLandmark(LandmarkId, static_cast<float>(Position[0]), static_cast<float>(Position[1]), static_cast<float>(Position[2]));
+				}
+			}
+			return !bError;
+		}
+
+		bool ParseHandedness(EHandedness& OutHandedness, bool& bOutValid)
+		{
+			const CharType* Begin;
+			int32 Length;
+			if (!ParseStringSpan(Begin, Length))
+			{
+				return false;
+			}
+
+			bOutValid = true;
+			if (EqualsIgnoreCase(Begin, Length, "Left"))
+			{
+				OutHandedness = EHandedness::Left;
+			}
+			else if (EqualsIgnoreCase(Begin, Length, "Right"))
+			{
+				OutHandedness = EHandedness::Right;
+			}
+			else
+			{
+				bOutValid = false;
+			}
+			return true;
+		}
+
+		bool ParseKey(EFrameKey& OutKey)
+		{
+			const CharType* Begin;
+			int32 Length;
+			if (!ParseStringSpan(Begin, Length) || !Expect(':'))
+			{
+				return false;
+			}
+
+			OutKey = EFrameKey::Unknown;
+			switch (Length)
+			{
+			case 1:
+				switch (Begin[0])
+				{
+				case 'x': OutKey = EFrameKey::X; break;
+				case 'y': OutKey = EFrameKey::Y; break;
+				case 'z': OutKey = EFrameKey::Z; break;
+				default: break;
+				}
+				break;
+			case 2:
+				if (Equals(Begin, Length, "id")) { OutKey = EFrameKey::Id; }
+				break;
+			case 4:
+				if (Equals(Begin, Length, "type")) { OutKey = EFrameKey::Type; }
+				break;
+			case 5:
+				if (Equals(Begin, Length, "hands")) { OutKey = EFrameKey::Hands; }
+				break;
+			case 9:
+				if (Equals(Begin, Length, "timestamp")) { OutKey = EFrameKey::Timestamp; }
+				else if (Equals(Begin, Length, "landmarks")) { OutKey = EFrameKey::Landmarks; }
+				break;
+			default:
+				break;
+			}
+			return true;
+		}
+
+		// 따옴표 안의 문자열 범위를 돌려준다. 이 형식의 키와 값에는 이스케이프가 없으므로 만나면 범용 파서에 맡긴다.
+		bool ParseStringSpan(const CharType*& OutBegin, int32& OutLength)
+		{
+			if (!Expect('"'))
+			{
+				return false;
+			}
+
+			OutBegin = Cursor;
+			while (Cursor < End && *Cursor != '"')
+			{
+				if (*Cursor == '\\')
+				{
+					return Fail();
+				}
+				++Cursor;
+			}
+			if (Cursor >= End)
+			{
+				return Fail();
+			}
+
+			OutLength = static_cast<int32>(Cursor - OutBegin);
+			++Cursor;
+			return true;
+		}
+
+		bool ParseNumber(double& OutValue)
+		{
+			SkipWhitespace();
+
+			const bool bNegative = (Cursor < End && *Cursor == '-');
+			if (bNegative)
+			{
+				++Cursor;
+			}
+
+			// 유효 숫자 19자리까지만 정수로 모으고 나머지는 지수로 넘긴다.
+			uint64 Mantissa = 0;
+			int32 Exponent = 0;
+			int32 SignificantDigits = 0;
+			int32 DigitCount = 0;
+			for (; Cursor < End && IsDigit(*Cursor); ++Cursor, ++DigitCount)
+			{
+				if (SignificantDigits < 19)
+				{
+					Mantissa = Mantissa * 10 + (*Cursor - '0');
+					SignificantDigits += (Mantissa != 0);
+				}
+				else
+				{
+					++Exponent;
+				}
+			}
+
+			if (Cursor < End && *Cursor == '.')
+			{
+				++Cursor;
+				for (; Cursor < End && IsDigit(*Cursor); ++Cursor, ++DigitCount)
+				{
+					if (SignificantDigits < 19)
+					{
+						Mantissa = Mantissa * 10 + (*Cursor - '0');
+						SignificantDigits += (Mantissa != 0);
+						--Exponent;
+					}
+				}
+			}
+
+			if (DigitCount == 0)
+			{
+				return Fail();
+			}
+
+			if (Cursor < End && (*Cursor == 'e' || *Cursor == 'E'))
+			{
+				++Cursor;
+				bool bNegativeExponent = false;
+				if (Cursor < End && (*Cursor == '+' || *Cursor == '-'))
+				{
+					bNegativeExponent = (*Cursor == '-');
+					++Cursor;
+				}
+
+				int32 ExplicitExponent = 0;
+				int32 ExponentDigits = 0;
+				for (; Cursor < End && IsDigit(*Cursor); ++Cursor, ++ExponentDigits)
+				{
+					ExplicitExponent = FMath::Min(ExplicitExponent * 10 + (*Cursor - '0'), 10000);
+				}
+				if (ExponentDigits == 0)
+				{
+					return Fail();
+				}
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+			}
+
+			double Value = static_cast<double>(Mantissa);
+			const int32 AbsExponent = FMath::Abs(Exponent);
+			const double Scale = (AbsExponent < static_cast<int32>(UE_ARRAY_COUNT(ExactPowersOfTen))) ? ExactPowersOfTen[AbsExponent] : FMath::Pow(10.0, static_cast<double>(AbsExponent));
+			Value = (Exponent < 0) ? Value / Scale : Value * Scale;
+
+			OutValue = bNegative ? -Value : Value;
+			return true;
+		}
+
+		// 관심 없는 값을 통째로 건너뛴다. 중첩된 객체/배열은 깊이만 세면서 넘긴다.
+		bool SkipValue()
+		{
+			SkipWhitespace();
+			if (Cursor >= End)
+			{
+				return Fail();
+			}
+
+			if (*Cursor == '"')
+			{
+				return SkipString();
+			}
+			if (*Cursor != '{' && *Cursor != '[')
+			{
+				// 숫자, true, false, null
+				const CharType* ValueBegin = Cursor;
+				while (Cursor < End && *Cursor != ',' && *Cursor != '}' && *Cursor != ']' && !IsWhitespace(*Cursor))
+				{
+					++Cursor;
+				}
+				return Cursor != ValueBegin || Fail();
+			}
+
+			int32 Depth = 0;
+			while (Cursor < End)
+			{
+				const CharType Char = *Cursor;
+				if (Char == '"')
+				{
+					if (!SkipString())
+					{
+						return false;
+					}
+					continue;
+				}
+
+				++Cursor;
+				if (Char == '{' || Char == '[')
+				{
+					++Depth;
+				}
+				else if ((Char == '}' || Char == ']') && --Depth == 0)
+				{
+					return true;
+				}
+			}
+			return Fail();
+		}
+
+		bool SkipString()
+		{
+			++Cursor;
+			while (Cursor < End)
+			{
+				if (*Cursor == '\\')
+				{
+					Cursor += 2;
+					continue;
+				}
+				if (*Cursor++ == '"')
+				{
+					return true;
+				}
+			}
+			return Fail();
+		}
+
+		bool BeginObject()
+		{
+			return Expect('{');
+		}
+
+		// 빈 컨테이너면 닫는 괄호까지 소비하고 true
+		bool TryEnd(char Close)
+		{
+			SkipWhitespace();
+			if (Cursor < End && *Cursor == Close)
+			{
+				++Cursor;
+				return true;
+			}
+			return false;
+		}
+
+		// 멤버 하나를 읽은 뒤: ','면 다음 멤버가 있고, 닫는 괄호면 끝. 그 외에는 형식 오류
+		bool NextMember(char Close)
+		{
+			SkipWhitespace();
+			if (Cursor < End)
+			{
+				if (*Cursor == ',')
+				{
+					++Cursor;
+					return true;
+				}
+				if (*Cursor == Close)
+				{
+					++Cursor;
+					return false;
+				}
+			}
+			return Fail();
+		}
+
+		bool Expect(char Expected)
+		{
+			SkipWhitespace();
+			if (Cursor < End && *Cursor == Expected)
+			{
+				++Cursor;
+				return true;
+			}
+			return Fail();
+		}
+
+		bool Fail()
+		{
+			bError = true;
+			return false;
+		}
+
+		void SkipWhitespace()
+		{
+			while (Cursor < End && IsWhitespace(*Cursor))
+			{
+				++Cursor;
+			}
+		}
+
+		static bool IsWhitespace(CharType Char)
+		{
+			return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+		}
+
+		static bool IsDigit(CharType Char)
+		{
+			return Char >= '0' && Char <= '9';
+		}
+
+		static bool Equals(const CharType* Text, int32 Length, const char* Literal)
+		{
+			for (int32 Index = 0; Index < Length; ++Index)
+			{
+				if (Literal[Index] == '\0' || Text[Index] != Literal[Index])
+				{
+					return false;
+				}
+			}
+			return Literal[Length] == '\0';
+		}
+
+		static bool EqualsIgnoreCase(const CharType* Text, int32 Length, const char* Literal)
+		{
+			for (int32 Index = 0; Index < Length; ++Index)
+			{
+				if (Literal[Index] == '\0' || FChar::ToLower(static_cast<TCHAR>(Text[Index])) != FChar::ToLower(static_cast<TCHAR>(Literal[Index])))
+				{
+					return false;
+				}
+			}
+			return Literal[Length] == '\0';
+		}
+
+		const CharType* Cursor;
+		const CharType* End;
+		// 중첩된 루프의 NextMember가 false를 돌려줄 때 정상 종료와 오류를 구분한다.
+		bool bError = false;
+	};
+}
+
+bool HandTrackingJsonParser::TryParseFrame(const ANSICHAR* Text, int32 Length, FHandTrackingFrame& OutFrame)
+{
+	return Text != nullptr && TFrameScanner<ANSICHAR>(Text, Length).ParseFrame(OutFrame);
+}
+
+bool HandTrackingJsonParser::TryParseFrame(const TCHAR* Text, int32 Length, FHandTrackingFrame& OutFrame)
+{
+	return Text != nullptr && TFrameScanner<TCHAR>(Text, Length).ParseFrame(OutFrame);
+}
@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingLatencyTracker.h"
+
+#include "Algo/Sort.h"
+
+void FHandTrackingLatencyTracker::AddSample(double LatencySeconds)
+{
+	SamplesMs[NextIndex] = static_cast<float>(LatencySeconds * 1000.0);
+	NextIndex = (NextIndex + 1) % WindowSize;
+	SampleCount = FMath::Min(SampleCount + 1, WindowSize);
+	bStatsDirty = true;
+}
+
+const FHandTrackingLatencyStats& FHandTrackingLatencyTracker::GetStats() const
+{
+	if (bStatsDirty)
+	{
+		// 원형 버퍼 순서는 그대로 두고 복사본을 정렬한다.
+		float Sorted[WindowSize];
+		FMemory::Memcpy(Sorted, SamplesMs, SampleCount * sizeof(float));
+		Algo::Sort(MakeArrayView(Sorted, SampleCount));
+
+		auto Percentile = [&Sorted, this](float Fraction)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * SampleCount) - 1, 0, SampleCount - 1);
+			return Sorted[Index];
+		};
+
+		CachedStats.P50Ms = Percentile(0.50f);
+		CachedStats.P95Ms = Percentile(0.95f);
+		CachedStats.P99Ms = Percentile(0.99f);
+		CachedStats.SampleCount = SampleCount;
+		bStatsDirty = false;
+	}
+	return CachedStats;
+}
+
+void FHandTrackingLatencyTracker::Reset()
+{
+	NextIndex = 0;
+	SampleCount = 0;
+	CachedStats = FHandTrackingLatencyStats();
+	bStatsDirty = false;
+}
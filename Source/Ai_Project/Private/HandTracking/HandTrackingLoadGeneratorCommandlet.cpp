@@ -0,0 +1,437 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingLoadGeneratorCommandlet.h"
+
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "HandTracking/HandTrackingProtocol.h"
+#include "HandTracking/HandTrackingStats.h"
+#include "HandTracking/HandTrackingSyntheticMotion.h"
+
+namespace
+{
+	constexpr double SpinWaitSeconds = 0.002;
+	constexpr double ControlPollSeconds = 0.001;
+	constexpr double StatsIntervalSeconds = 1.0;
+
+	template <typename EnumType>
+	void ParseEnumValue(const FString& Params, const TCHAR* Key, EnumType& InOutValue)
+	{
+		FString Name;
+		if (FParse::Value(*Params, Key, Name))
+		{
+			const int64 Value = StaticEnum<EnumType>()->GetValueByNameString(Name);
+			if (Value != INDEX_NONE)
+			{
+				InOutValue = static_cast<EnumType>(Value);
+			}
+			else
+			{
+				UE_LOG(LogHandTracking, Warning, TEXT("Unknown value '%s' for %s"), *Name, Key);
+			}
+		}
+	}
+
+	float NextGaussian(FRandomStream& RandomStream)
+	{
+		const float U1 = FMath::Max(RandomStream.GetFraction(), UE_SMALL_NUMBER);
+		const float U2 = RandomStream.GetFraction();
+		return FMath::Sqrt(-2.0f * FMath::Loge(U1)) * FMath::Cos(2.0f * PI * U2);
+	}
+}
+
+UHandTrackingLoadGeneratorCommandlet::UHandTrackingLoadGeneratorCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UHandTrackingLoadGeneratorCommandlet::Main(const FString& Params)
+{
+	ParseEnumValue(Params, TEXT("Transport="), Transport);
+	ParseEnumValue(Params, TEXT("Format="), WireFormat);
+	FParse::Value(*Params, TEXT("Address="), Address);
+	FParse::Value(*Params, TEXT("Port="), Port);
+
+	if (Transport == EHandTrackingTransport::SharedMemory || Transport == EHandTrackingTransport::Replay)
+	{
+		UE_LOG(LogHandTracking, Error, TEXT("Load generator only sends over Tcp or Udp."));
+		return 1;
+	}
+
+	float Rate = 60.0f;
+	float DurationSeconds = 0.0f;
+	float TimingJitterMs = 0.0f;
+	float LossProbability = 0.0f;
+	int32 LossBurst = 1;
+	FHandTrackingSyntheticMotionSettings MotionSettings;
+	FParse::Value(*Params, TEXT("Rate="), Rate);
+	FParse::Value(*Params, TEXT("Hands="), MotionSettings.NumHands);
+	FParse::Value(*Params, TEXT("Duration="), DurationSeconds);
+	FParse::Value(*Params, TEXT("Jitter="), MotionSettings.LandmarkJitter);
+	FParse::Value(*Params, TEXT("TimingJitterMs="), TimingJitterMs);
+	FParse::Value(*Params, TEXT("Loss="), LossProbability);
+	FParse::Value(*Params, TEXT("LossBurst="), LossBurst);
+	FParse::Value(*Params, TEXT("Seed="), MotionSettings.Seed);
+	const bool bObeyControl = !FParse::Param(*Params, TEXT("IgnoreControl"));
+	float ClockOffsetMs = 0.0f;
+	float ClockDriftPpm = 0.0f;
+	FParse::Value(*Params, TEXT("ClockOffsetMs="), ClockOffsetMs);
+	FParse::Value(*Params, TEXT("ClockDriftPpm="), ClockDriftPpm);
+	ClockOffsetSeconds = ClockOffsetMs * 1.0e-3;
+	ClockDrift = ClockDriftPpm * 1.0e-6;
+
+	FHandTrackingCompactEncoderSettings CompactSettings;
+	FParse::Value(*Params, TEXT("KeyframeInterval="), CompactSettings.KeyframeInterval);
+	FParse::Value(*Params, TEXT("DeltaThreshold="), CompactSettings.DeltaThreshold);
+	FParse::Value(*Params, TEXT("FractionBits="), CompactSettings.FractionBits);
+	CompactEncoder = MakeUnique<FHandTrackingCompactEncoder>(CompactSettings);
+
+	Rate = FMath::Clamp(Rate, 1.0f, 1000.0f);
+	MotionSettings.NumHands = FMath::Clamp(MotionSettings.NumHands, 0, MaxTrackedHands);
+	LossProbability = FMath::Clamp(LossProbability, 0.0f, 1.0f);
+	LossBurst = FMath::Max(LossBurst, 1);
+
+	if (!OpenSockets())
+	{
+		return 1;
+	}
+
+	UE_LOG(LogHandTracking, Display, TEXT("Hand tracking load generator: %s/%s on %s:%d, %.0f Hz, %d hands, jitter %.4f, timing jitter %.2f ms, loss %.3f x%d"),
+		*StaticEnum<EHandTrackingTransport>()->GetNameStringByValue(static_cast<int64>(Transport)),
+		*StaticEnum<EHandTrackingWireFormat>()->GetNameStringByValue(static_cast<int64>(WireFormat)),
+		*Address, Port, Rate, MotionSettings.NumHands, MotionSettings.LandmarkJitter, TimingJitterMs, LossProbability, LossBurst);
+
+	FHandTrackingSyntheticMotion Motion(MotionSettings);
+	// 손실/타이밍은 움직임 노이즈와 다른 스트림을 써서 옵션을 바꿔도 손 모양 열은 그대로 유지한다.
+	FRandomStream NetworkRandom(static_cast<int32>(MotionSettings.Seed) ^ 0x5A5A5A5A);
+
+	double FrameInterval = 1.0 / Rate;
+	uint8 HandMask = (1u << MaxTrackedHands) - 1;
+	const double StartTime = FPlatformTime::Seconds();
+	ClockStartTime = StartTime;
+	double NextFrameTime = StartTime;
+	double StatsStartTime = StartTime;
+
+	FHandTrackingFrame Frame;
+	TArray<uint8> Bytes;
+	uint32 Sequence = 0;
+	int32 RemainingLossBurst = 0;
+	int32 SentFrames = 0;
+	int64 SentBytes = 0;
+	int32 LostFrames = 0;
+	int32 LateFrames = 0;
+
+	while (!IsEngineExitRequested())
+	{
+		double Now = FPlatformTime::Seconds();
+		if (DurationSeconds > 0.0f && Now - StartTime >= DurationSeconds)
+		{
+			break;
+		}
+
+		if (Transport == EHandTrackingTransport::Tcp && ClientSocket == nullptr)
+		{
+			if (AcceptClient())
+			{
+				NextFrameTime = FPlatformTime::Seconds();
+			}
+			continue;
+		}
+
+		if (bHasPendingControlMessage && bObeyControl)
+		{
+			const FHandTrackingControlMessage& ControlMessage = PendingControlMessage;
+			const float RequestedRate = (ControlMessage.RequestedRate > 0.0f) ? FMath::Clamp(ControlMessage.RequestedRate, 1.0f, 1000.0f) : Rate;
+			if (RequestedRate != Rate || ControlMessage.HandMask != HandMask)
+			{
+				UE_LOG(LogHandTracking, Display, TEXT("Control #%u: %.1f Hz -> %.1f Hz, hand mask %u -> %u (headroom %.2f)"),
+					ControlMessage.Sequence, Rate, RequestedRate, HandMask, ControlMessage.HandMask, ControlMessage.Headroom);
+			}
+			if (ControlMessage.bHasRegionOfInterest)
+			{
+				// 합성 움직임은 이미지가 없어 잘라 볼 것이 없다. 확인용으로만 찍는다.
+				UE_LOG(LogHandTracking, Verbose, TEXT("Control #%u: region of interest (%.3f, %.3f) - (%.3f, %.3f)"), ControlMessage.Sequence,
+					ControlMessage.RegionOfInterest.Min.X, ControlMessage.RegionOfInterest.Min.Y, ControlMessage.RegionOfInterest.Max.X, ControlMessage.RegionOfInterest.Max.Y);
+			}
+			Rate = RequestedRate;
+			FrameInterval = 1.0 / Rate;
+			HandMask = ControlMessage.HandMask;
+		}
+		bHasPendingControlMessage = false;
+
+		const double JitterSeconds = (TimingJitterMs > 0.0f) ? NextGaussian(NetworkRandom) * TimingJitterMs * 1.0e-3 : 0.0;
+		WaitUntil(NextFrameTime + JitterSeconds);
+		NextFrameTime += FrameInterval;
+		if (Transport == EHandTrackingTransport::Tcp && ClientSocket == nullptr)
+		{
+			// 기다리는 동안 핑 응답을 보내다가 끊겼다.
+			continue;
+		}
+
+		// 한참 밀렸으면 한꺼번에 몰아 보내지 않고 일정을 다시 잡는다.
+		Now = FPlatformTime::Seconds();
+		if (Now - NextFrameTime > 4.0 * FrameInterval)
+		{
+			++LateFrames;
+			NextFrameTime = Now;
+		}
+
+		++Sequence;
+		if (RemainingLossBurst == 0 && LossProbability > 0.0f && NetworkRandom.GetFraction() < LossProbability)
+		{
+			RemainingLossBurst = LossBurst;
+		}
+		if (RemainingLossBurst > 0)
+		{
+			--RemainingLossBurst;
+			++LostFrames;
+			continue;
+		}
+
+		Motion.Generate(Now - StartTime, Frame);
+		if (HandMask != (1u << MaxTrackedHands) - 1)
+		{
+			int32 NumKept = 0;
+			for (int32 HandIndex = 0; HandIndex < Frame.NumHands; ++HandIndex)
+			{
+				if (HandMask & (1u << static_cast<int32>(Frame.Hands[HandIndex].Handedness)))
+				{
+					if (NumKept != HandIndex)
+					{
+						Frame.Hands[NumKept] = Frame.Hands[HandIndex];
+					}
+					++NumKept;
+				}
+			}
+			Frame.NumHands = NumKept;
+		}
+		Frame.CaptureTimestamp = GetTrackerTime(Now);
+		Frame.Sequence = Sequence;
+
+		Bytes.Reset();
+		if (Transport == EHandTrackingTransport::Udp)
+		{
+			HandTrackingProtocol::WriteDatagramHeader(Bytes, Sequence, static_cast<uint64>(Frame.CaptureTimestamp * 1.0e6));
+		}
+		if (WireFormat == EHandTrackingWireFormat::Compact)
+		{
+			CompactEncoder->Encode(Frame, Bytes);
+		}
+		else
+		{
+			HandTrackingProtocol::EncodeFrame(WireFormat, Frame, Bytes);
+		}
+
+		if (SendFrame(Bytes))
+		{
+			++SentFrames;
+			SentBytes += Bytes.Num();
+		}
+
+		if (Now - StatsStartTime >= StatsIntervalSeconds)
+		{
+			UE_LOG(LogHandTracking, Display, TEXT("Sent %d frames (%.1f Hz, %.1f KB/s, %.0f bytes/frame), skipped %d as loss, %d schedule overruns"),
+				SentFrames, SentFrames / (Now - StatsStartTime), SentBytes / 1024.0 / (Now - StatsStartTime),
+				SentFrames > 0 ? static_cast<double>(SentBytes) / SentFrames : 0.0, LostFrames, LateFrames);
+			StatsStartTime = Now;
+			SentFrames = 0;
+			SentBytes = 0;
+			LostFrames = 0;
+			LateFrames = 0;
+		}
+	}
+
+	CloseSockets();
+	return 0;
+}
+
+bool UHandTrackingLoadGeneratorCommandlet::OpenSockets()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FIPv4Address IP;
+	if (SocketSubsystem == nullptr || !FIPv4Address::Parse(Address, IP))
+	{
+		UE_LOG(LogHandTracking, Error, TEXT("Invalid IP Address."));
+		return false;
+	}
+
+	if (Transport == EHandTrackingTransport::Udp)
+	{
+		DatagramSocket = FUdpSocketBuilder(TEXT("HandTrackingLoadGeneratorUdp"))
+			.WithSendBufferSize(256 * 1024)
+			.Build();
+
+		RemoteAddr = SocketSubsystem->CreateInternetAddr();
+		RemoteAddr->SetIp(IP.Value);
+		RemoteAddr->SetPort(Port);
+		return DatagramSocket != nullptr;
+	}
+
+	// 파이썬 트래커처럼 서버가 되어 게임의 접속을 받는다.
+	ListenSocket = FTcpSocketBuilder(TEXT("HandTrackingLoadGeneratorListen"))
+		.AsReusable()
+		.BoundToEndpoint(FIPv4Endpoint(IP, Port))
+		.Listening(1)
+		.Build();
+
+	if (ListenSocket == nullptr)
+	{
+		UE_LOG(LogHandTracking, Error, TEXT("Could not listen on %s:%d."), *Address, Port);
+		return false;
+	}
+	UE_LOG(LogHandTracking, Display, TEXT("Waiting for the game to connect on %s:%d."), *Address, Port);
+	return true;
+}
+
+void UHandTrackingLoadGeneratorCommandlet::CloseSockets()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	for (FSocket** SocketPtr : { &ClientSocket, &ListenSocket, &DatagramSocket })
+	{
+		if (*SocketPtr)
+		{
+			(*SocketPtr)->Close();
+			SocketSubsystem->DestroySocket(*SocketPtr);
+			*SocketPtr = nullptr;
+		}
+	}
+}
+
+bool UHandTrackingLoadGeneratorCommandlet::AcceptClient()
+{
+	bool bHasPendingConnection = false;
+	if (!ListenSocket->WaitForPendingConnection(bHasPendingConnection, FTimespan::FromMilliseconds(100)) || !bHasPendingConnection)
+	{
+		return false;
+	}
+
+	ClientSocket = ListenSocket->Accept(TEXT("HandTrackingLoadGeneratorClient"));
+	if (ClientSocket == nullptr)
+	{
+		return false;
+	}
+
+	ClientSocket->SetNoDelay(true);
+	// 새 연결은 이전 키프레임을 모른다.
+	CompactEncoder->ForceKeyframe();
+	ControlBuffer.Reset();
+	bHasPendingControlMessage = false;
+	UE_LOG(LogHandTracking, Display, TEXT("Game connected, streaming frames."));
+	return true;
+}
+
+bool UHandTrackingLoadGeneratorCommandlet::SendFrame(const TArray<uint8>& Bytes)
+{
+	int32 BytesSent = 0;
+	if (Transport == EHandTrackingTransport::Udp)
+	{
+		return DatagramSocket->SendTo(Bytes.GetData(), Bytes.Num(), BytesSent, *RemoteAddr);
+	}
+
+	// 블로킹 소켓이라 게임 쪽 수신이 밀리면 파이썬 트래커처럼 여기서 기다린다.
+	int32 Offset = 0;
+	while (Offset < Bytes.Num())
+	{
+		if (!ClientSocket->Send(Bytes.GetData() + Offset, Bytes.Num() - Offset, BytesSent) || BytesSent <= 0)
+		{
+			UE_LOG(LogHandTracking, Display, TEXT("Game disconnected, waiting for a new connection."));
+			ClientSocket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ClientSocket);
+			ClientSocket = nullptr;
+			return false;
+		}
+		Offset += BytesSent;
+	}
+	return true;
+}
+
+void UHandTrackingLoadGeneratorCommandlet::PollControlSocket()
+{
+	// 게임은 프레임을 보낸 주소로 답하므로 Udp는 송신 소켓에서 읽는다. 데이터그램 하나가 줄 하나다.
+	FSocket* ControlSocket = (Transport == EHandTrackingTransport::Udp) ? DatagramSocket : ClientSocket;
+	if (ControlSocket == nullptr)
+	{
+		return;
+	}
+
+	uint32 PendingSize = 0;
+	while (ControlSocket->HasPendingData(PendingSize) && PendingSize > 0)
+	{
+		const int32 Offset = ControlBuffer.Num();
+		ControlBuffer.AddUninitialized(static_cast<int32>(PendingSize));
+		int32 BytesRead = 0;
+		if (!ControlSocket->Recv(ControlBuffer.GetData() + Offset, static_cast<int32>(PendingSize), BytesRead, ESocketReceiveFlags::None))
+		{
+			BytesRead = 0;
+		}
+		ControlBuffer.SetNum(Offset + BytesRead, false);
+		if (BytesRead <= 0)
+		{
+			break;
+		}
+	}
+
+	// 줄 단위로 자르고, 제어 메시지가 한 번에 여럿 왔으면 마지막 것만 쓴다.
+	int32 LineStart = 0;
+	for (int32 Index = 0; Index < ControlBuffer.Num(); ++Index)
+	{
+		if (ControlBuffer[Index] != '\n')
+		{
+			continue;
+		}
+		const double ReceiveTime = GetTrackerTime(FPlatformTime::Seconds());
+		FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(ControlBuffer.GetData() + LineStart), Index - LineStart);
+		const FString Line(Converted.Length(), Converted.Get());
+		LineStart = Index + 1;
+
+		FHandTrackingClockReply ClockReply;
+		if (HandTrackingProtocol::ParsePing(Line, ClockReply.Sequence, ClockReply.PingTimeUs))
+		{
+			TArray<uint8> ReplyBytes;
+			ClockReply.TrackerReceiveTimeUs = static_cast<uint64>(ReceiveTime * 1.0e6);
+			ClockReply.TrackerSendTimeUs = static_cast<uint64>(GetTrackerTime(FPlatformTime::Seconds()) * 1.0e6);
+			HandTrackingProtocol::EncodeClockReply(ClockReply, ReplyBytes);
+			if (!SendFrame(ReplyBytes))
+			{
+				return;
+			}
+		}
+		else if (HandTrackingProtocol::ParseControlMessage(Line, PendingControlMessage))
+		{
+			bHasPendingControlMessage = true;
+		}
+		else
+		{
+			UE_LOG(LogHandTracking, Warning, TEXT("Ignoring malformed control message: %s"), *Line);
+		}
+	}
+	ControlBuffer.RemoveAt(0, LineStart, false);
+}
+
+double UHandTrackingLoadGeneratorCommandlet::GetTrackerTime(double Now) const
+{
+	return Now + ClockOffsetSeconds + ClockDrift * (Now - ClockStartTime);
+}
+
+void UHandTrackingLoadGeneratorCommandlet::WaitUntil(double TargetTime)
+{
+	for (;;)
+	{
+		PollControlSocket();
+
+		const double Remaining = TargetTime - FPlatformTime::Seconds();
+		if (Remaining <= 0.0)
+		{
+			return;
+		}
+		const double SleepSeconds = (Remaining > SpinWaitSeconds) ? Remaining - SpinWaitSeconds : 0.0;
+		FPlatformProcess::Sleep(static_cast<float>((ClientSocket != nullptr || DatagramSocket != nullptr) ? FMath::Min(SleepSeconds, ControlPollSeconds) : SleepSeconds));
+	}
+}
@@ -0,0 +1,221 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingPosePipeline.h"
+
+#include "HandTracking/HandTrackingFingerSolver.h"
+#include "HandTracking/HandTrackingSettings.h"
+#include "HandTracking/HandTrackingStats.h"
+
+namespace
+{
+	// 트래커 시계가 다른 기준(예: 유닉스 시각)이면 말이 안 되는 값이 나오므로 버린다.
+	constexpr double MaxPlausibleLatencySeconds = 5.0;
+	// 캡처 -> 수신 지연 평활 계수 (프레임마다)
+	constexpr double CaptureLatencyAlpha = 0.1;
+
+	// 엔진 시계 기준 캡처 시각. 트래커와 시계를 맞췄으면 그 값, 아니면 트래커가 같은 시계를 쓰는 것으로 보일 때만 캡처 시각 그대로. 모르면 0
+	double GetEngineCaptureTime(const FHandTrackingFrame& Frame, double Now)
+	{
+		if (Frame.EngineCaptureTime > 0.0)
+		{
+			return Frame.EngineCaptureTime;
+		}
+		if (Frame.CaptureTimestamp > 0.0)
+		{
+			const double CaptureAge = Now - Frame.CaptureTimestamp;
+			if (CaptureAge >= 0.0 && CaptureAge < MaxPlausibleLatencySeconds)
+			{
+				return Frame.CaptureTimestamp;
+			}
+		}
+		return 0.0;
+	}
+}
+
+FHandTrackingPosePipelineParams FHandTrackingPosePipelineParams::FromSettings()
+{
+	const UHandTrackingSettings* Settings = GetDefault<UHandTrackingSettings>();
+
+	FHandTrackingPosePipelineParams Params;
+	Params.Calibration = FHandTrackingCalibration::FromSettings();
+	Params.FilterParams = FHandTrackingFilterParams::FromSettings();
+	Params.PlayoutDelay = Settings->PlayoutDelay;
+	Params.AssumedCaptureLatency = Settings->AssumedCaptureLatency;
+	return Params;
+}
+
+FHandTrackingPosePipeline::FHandTrackingPosePipeline(int32 InStreamId, const FHandTrackingPosePipelineParams& InParams)
+	: StreamId(InStreamId)
+	, Params(InParams)
+	, Pipe(TEXT("HandTrackingPosePipeline"))
+{
+	for (int32 HandIndex = 0; HandIndex < MaxTrackedHands; ++HandIndex)
+	{
+		HandPredictors[HandIndex].SetParams(Params.FilterParams);
+		HandPredictors[HandIndex].Reset();
+		HandJitterBuffers[HandIndex].Reset();
+	}
+}
+
+FHandTrackingPosePipeline::~FHandTrackingPosePipeline()
+{
+	Flush();
+}
+
+void FHandTrackingPosePipeline::PushFrame(const FHandTrackingDecodeTask& DecodeTask)
+{
+	// 디코딩이 끝나는 대로 같은 워커에서 이어 돈다. 디코딩에 실패해도 센 프레임 수는 맞춘다.
+	Pipe.Launch(TEXT("HandTrackingPoseIngest"), [this, DecodeTask]()
+	{
+		const TSharedPtr<const FHandTrackingFrame, ESPMode::ThreadSafe>& Frame = DecodeTask.GetResult();
+		if (Frame.IsValid())
+		{
+			IngestFrame(*Frame);
+		}
+		++State.FrameCount;
+		SolveAndPublish();
+	}, UE::Tasks::Prerequisites(DecodeTask));
+}
+
+void FHandTrackingPosePipeline::RequestDisplayTime(double DisplayTime)
+{
+	Pipe.Launch(TEXT("HandTrackingPoseSolve"), [this, DisplayTime]()
+	{
+		TargetDisplayTime = DisplayTime;
+		SolveAndPublish();
+	});
+}
+
+const FHandTrackingPipelineSnapshot* FHandTrackingPosePipeline::AcquireLatest()
+{
+	if ((MiddleIndex.load(std::memory_order_relaxed) & NewSnapshotFlag) == 0)
+	{
+		return nullptr;
+	}
+	// 다 읽은 앞 버퍼를 가운데에 두고 새 자세를 가져온다. acquire로 파이프가 쓴 내용을 본다.
+	const int32 Previous = MiddleIndex.exchange(FrontIndex, std::memory_order_acq_rel);
+	FrontIndex = Previous & ~NewSnapshotFlag;
+	return &Buffers[FrontIndex];
+}
+
+void FHandTrackingPosePipeline::Flush()
+{
+	Pipe.WaitUntilEmpty();
+}
+
+void FHandTrackingPosePipeline::IngestFrame(const FHandTrackingFrame& Frame)
+{
+	const double Now = FPlatformTime::Seconds();
+	const double CaptureTime = EstimateCaptureTime(Frame, Now);
+	for (int32 HandIndex = 0; HandIndex < Frame.NumHands; ++HandIndex)
+	{
+		const FHandFrame& TrackerHand = Frame.Hands[HandIndex];
+		if (TrackerHand.ValidMask == 0)
+		{
+			continue;
+		}
+
+		FHandFrame Hand;
+		{
+			HANDTRACKING_SCOPE(Convert);
+			// 랜드마크 21개를 한 번에 변환한다. 빠진 랜드마크 칸도 같이 계산되지만 유효 비트가 꺼져 있어 쓰이지 않는다.
+			Params.Calibration.TransformHand(TrackerHand, Hand);
+		}
+		{
+			HANDTRACKING_SCOPE(Filter);
+			const int32 Index = static_cast<int32>(Hand.Handedness);
+			HandPredictors[Index].AddSample(Hand, CaptureTime);
+			HandJitterBuffers[Index].Push(HandPredictors[Index].GetFiltered(), CaptureTime);
+		}
+	}
+
+	// 캡처 시각을 모르면 이 값이 AssumedCaptureLatency 그대로다.
+	const double ArrivalTime = (Frame.ArrivalTime > 0.0) ? Frame.ArrivalTime : Now;
+	const double Latency = FMath::Max(ArrivalTime - CaptureTime, 0.0);
+	CaptureLatency = (CaptureLatency < 0.0) ? Latency : CaptureLatency + CaptureLatencyAlpha * (Latency - CaptureLatency);
+
+	State.ArrivalTime = Frame.ArrivalTime;
+	State.CaptureTime = GetEngineCaptureTime(Frame, Now);
+}
+
+void FHandTrackingPosePipeline::SolveAndPublish()
+{
+	// 버퍼는 캡처 시각 기준이다. 표시 시각에서 캡처 -> 수신 지연을 빼면 지금 막 도착하는 프레임의 캡처 시각이고,
+	// 거기서 재생 지연만큼 더 앞선 시각은 대개 받은 두 프레임 사이에 있다. 거기서 보간한 손을 예측기의 속도/가속도로 표시 시각까지 옮긴다.
+	// 그보다 새 프레임이 없으면 마지막 필터 결과에서 표시 시각까지 외삽한다.
+	const double Latency = (CaptureLatency >= 0.0) ? CaptureLatency : Params.AssumedCaptureLatency;
+	const double PlayoutTime = TargetDisplayTime - Latency - Params.PlayoutDelay;
+
+	bool bAnyHand = false;
+	bool bStillPlaying = false;
+	for (int32 HandIndex = 0; HandIndex < MaxTrackedHands; ++HandIndex)
+	{
+		FHandFrame Hand;
+		{
+			HANDTRACKING_SCOPE(Filter);
+			const FHandTrackingJitterBuffer::ESampleResult Result = HandJitterBuffers[HandIndex].Sample(PlayoutTime, Hand);
+			State.JitterStats[HandIndex] = HandJitterBuffers[HandIndex].GetStats();
+			if (Result == FHandTrackingJitterBuffer::ESampleResult::Empty)
+			{
+				continue;
+			}
+			// 재생할 프레임이 남아 있으면 이번에 그대로여도 다음 틱에는 움직인다.
+			bStillPlaying |= (Result == FHandTrackingJitterBuffer::ESampleResult::Interpolated || Result == FHandTrackingJitterBuffer::ESampleResult::BeforeOldest);
+			if (Result == FHandTrackingJitterBuffer::ESampleResult::Underflow)
+			{
+				HandPredictors[HandIndex].Predict(TargetDisplayTime, Hand);
+			}
+			else
+			{
+				// 캡처 -> 수신 지연과 재생 지연만큼 앞당긴다 (MaxPredictionHorizon까지).
+				HandPredictors[HandIndex].Advance(Hand, PlayoutTime, TargetDisplayTime, Hand);
+			}
+		}
+		// 새 데이터가 없고 외삽도 끝까지 간 손은 지난번과 똑같으므로 다시 풀지 않는다.
+		if (Hand.ValidMask == 0 || Hand.Equals(State.Hands[HandIndex]))
+		{
+			continue;
+		}
+		State.Hands[HandIndex] = Hand;
+		bAnyHand = true;
+	}
+
+	if (bAnyHand)
+	{
+		HANDTRACKING_SCOPE(Solve);
+		// 양손의 손가락 체인을 한 번에 푼다. 결과는 UAI_Anim을 거쳐 FAnimNode_HandTrackingPose가 본에 적용한다.
+		HandTrackingFingerSolver::Solve(State.Hands, MaxTrackedHands, Params.MinLandmarkConfidence, State.Poses);
+	}
+	State.bStillMoving = bAnyHand || bStillPlaying;
+
+#if STATS
+	FHandTrackingJitterBufferStats JitterStats;
+	for (const FHandTrackingJitterBufferStats& HandStats : State.JitterStats)
+	{
+		JitterStats.BufferedFrames = FMath::Max(JitterStats.BufferedFrames, HandStats.BufferedFrames);
+		JitterStats.Underflows += HandStats.Underflows;
+		JitterStats.Overflows += HandStats.Overflows;
+	}
+	SET_DWORD_STAT(STAT_HandTracking_JitterBufferDepth, JitterStats.BufferedFrames);
+	SET_DWORD_STAT(STAT_HandTracking_JitterUnderflows, JitterStats.Underflows);
+	SET_DWORD_STAT(STAT_HandTracking_JitterOverflows, JitterStats.Overflows);
+#endif
+
+	// 뒤 버퍼에 채워 가운데와 바꾼다. release로 게임 스레드가 교환한 뒤에 다 쓴 내용을 보게 한다.
+	Buffers[BackIndex] = State;
+	const int32 Previous = MiddleIndex.exchange(BackIndex | NewSnapshotFlag, std::memory_order_acq_rel);
+	BackIndex = Previous & ~NewSnapshotFlag;
+}
+
+double FHandTrackingPosePipeline::EstimateCaptureTime(const FHandTrackingFrame& Frame, double Now) const
+{
+	const double CaptureTime = GetEngineCaptureTime(Frame, Now);
+	if (CaptureTime > 0.0)
+	{
+		return CaptureTime;
+	}
+	// 캡처 시각을 모르면 측정한 수신 시각에서 카메라/추론 지연만큼 되돌린다.
+	const double ArrivalTime = (Frame.ArrivalTime > 0.0) ? Frame.ArrivalTime : Now;
+	return ArrivalTime - Params.AssumedCaptureLatency;
+}
@@ -0,0 +1,163 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingPosePredictor.h"
+
+#include "HandTracking/HandTrackingSettings.h"
+
+namespace
+{
+	// 같은 시각에 두 표본이 들어와도 미분이 터지지 않게 하는 최소 간격(초)
+	constexpr double MinSampleInterval = 1.0e-3;
+
+	// One-Euro 저역 통과 계수: alpha = 1 / (1 + tau / dt), tau = 1 / (2 pi fc)
+	FORCEINLINE float SmoothingFactor(float Cutoff, float DeltaTime)
+	{
+		const float K = UE_TWO_PI * Cutoff * DeltaTime;
+		return K / (K + 1.0f);
+	}
+}
+
+FHandTrackingFilterParams FHandTrackingFilterParams::FromSettings()
+{
+	const UHandTrackingSettings* Settings = GetDefault<UHandTrackingSettings>();
+
+	FHandTrackingFilterParams Params;
+	Params.MinCutoff = Settings->FilterMinCutoff;
+	Params.Beta = Settings->FilterBeta;
+	Params.DerivativeCutoff = Settings->FilterDerivativeCutoff;
+	Params.MaxPredictionHorizon = Settings->MaxPredictionHorizon;
+	Params.bPredict = Settings->bEnablePrediction;
+	return Params;
+}
+
+void FHandTrackingPosePredictor::AddSample(const FHandFrame& Hand, double SampleTime)
+{
+	const double Interval = SampleTime - LastSampleTime;
+	if (!bHasState || Interval > Params.ResetInterval || Interval < -Params.ResetInterval)
+	{
+		// 처음이거나 오래 끊겼다가 다시 들어오면 측정값에서 새로 시작한다.
+		Reset();
+		bHasState = true;
+	}
+
+	// 새로 들어온 랜드마크는 측정값 그대로, 속도 0에서 시작한다. 아래 필터를 거쳐도 값이 그대로 남는다.
+	for (uint32 Mask = Hand.ValidMask & ~Filtered.ValidMask; Mask != 0; Mask &= Mask - 1)
+	{
+		const int32 Id = FMath::CountTrailingZeros(Mask);
+		Filtered.X[Id] = Hand.X[Id];
+		Filtered.Y[Id] = Hand.Y[Id];
+		Filtered.Z[Id] = Hand.Z[Id];
+		VelocityX[Id] = VelocityY[Id] = VelocityZ[Id] = 0.0f;
+		AccelerationX[Id] = AccelerationY[Id] = AccelerationZ[Id] = 0.0f;
+	}
+
+	const float DeltaTime = static_cast<float>(FMath::Max(Interval, MinSampleInterval));
+	const VectorRegister4Float InvDeltaTime = VectorSetFloat1(1.0f / DeltaTime);
+	const VectorRegister4Float DerivativeAlpha = VectorSetFloat1(SmoothingFactor(Params.DerivativeCutoff, DeltaTime));
+	const VectorRegister4Float MinCutoffK = VectorSetFloat1(UE_TWO_PI * DeltaTime * Params.MinCutoff);
+	const VectorRegister4Float BetaK = VectorSetFloat1(UE_TWO_PI * DeltaTime * Params.Beta);
+	const VectorRegister4Float One = VectorSetFloat1(1.0f);
+
+	// 빠진 랜드마크 칸도 같이 계산되지만 유효 비트가 꺼지고, 다시 들어오면 위에서 새로 시작한다.
+	for (int32 Base = 0; Base < FHandFrame::PaddedLandmarkCount; Base += 4)
+	{
+		const VectorRegister4Float X = VectorLoad(Hand.X + Base);
+		const VectorRegister4Float Y = VectorLoad(Hand.Y + Base);
+		const VectorRegister4Float Z = VectorLoad(Hand.Z + Base);
+		const VectorRegister4Float PrevX = VectorLoad(Filtered.X + Base);
+		const VectorRegister4Float PrevY = VectorLoad(Filtered.Y + Base);
+		const VectorRegister4Float PrevZ = VectorLoad(Filtered.Z + Base);
+		const VectorRegister4Float PrevVX = VectorLoad(VelocityX + Base);
+		const VectorRegister4Float PrevVY = VectorLoad(VelocityY + Base);
+		const VectorRegister4Float PrevVZ = VectorLoad(VelocityZ + Base);
+
+		// 속도: (측정값 - 이전 결과) / dt를 고정 차단 주파수로 거른다.
+		const VectorRegister4Float DeltaX = VectorSubtract(X, PrevX);
+		const VectorRegister4Float DeltaY = VectorSubtract(Y, PrevY);
+		const VectorRegister4Float DeltaZ = VectorSubtract(Z, PrevZ);
+		const VectorRegister4Float VX = VectorMultiplyAdd(VectorSubtract(VectorMultiply(DeltaX, InvDeltaTime), PrevVX), DerivativeAlpha, PrevVX);
+		const VectorRegister4Float VY = VectorMultiplyAdd(VectorSubtract(VectorMultiply(DeltaY, InvDeltaTime), PrevVY), DerivativeAlpha, PrevVY);
+		const VectorRegister4Float VZ = VectorMultiplyAdd(VectorSubtract(VectorMultiply(DeltaZ, InvDeltaTime), PrevVZ), DerivativeAlpha, PrevVZ);
+
+		// 위치: 빠를수록 차단 주파수를 올린다. 세 성분이 같은 계수를 쓰도록 속력으로 정한다.
+		const VectorRegister4Float Speed = VectorSqrt(VectorMultiplyAdd(VX, VX, VectorMultiplyAdd(VY, VY, VectorMultiply(VZ, VZ))));
+		const VectorRegister4Float K = VectorMultiplyAdd(BetaK, Speed, MinCutoffK);
+		const VectorRegister4Float Alpha = VectorDivide(K, VectorAdd(K, One));
+		VectorStore(VectorMultiplyAdd(DeltaX, Alpha, PrevX), Filtered.X + Base);
+		VectorStore(VectorMultiplyAdd(DeltaY, Alpha, PrevY), Filtered.Y + Base);
+		VectorStore(VectorMultiplyAdd(DeltaZ, Alpha, PrevZ), Filtered.Z + Base);
+
+		// 가속도: 걸러진 속도의 변화량을 다시 같은 차단 주파수로 거른다.
+		auto UpdateAcceleration = [&](float* Acceleration, const VectorRegister4Float& NewVelocity, const VectorRegister4Float& PrevVelocity)
+		{
+			const VectorRegister4Float PrevA = VectorLoad(Acceleration + Base);
+			const VectorRegister4Float RawA = VectorMultiply(VectorSubtract(NewVelocity, PrevVelocity), InvDeltaTime);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(RawA, PrevA), DerivativeAlpha, PrevA), Acceleration + Base);
+		};
+		UpdateAcceleration(AccelerationX, VX, PrevVX);
+		UpdateAcceleration(AccelerationY, VY, PrevVY);
+		UpdateAcceleration(AccelerationZ, VZ, PrevVZ);
+
+		VectorStore(VX, VelocityX + Base);
+		VectorStore(VY, VelocityY + Base);
+		VectorStore(VZ, VelocityZ + Base);
+	}
+
+	Filtered.Handedness = Hand.Handedness;
+	Filtered.ValidMask = Hand.ValidMask;
+	FMemory::Memcpy(Filtered.Confidence, Hand.Confidence, sizeof(Filtered.Confidence));
+	LastSampleTime = SampleTime;
+}
+
+bool FHandTrackingPosePredictor::Predict(double TargetTime, FHandFrame& OutHand) const
+{
+	return Advance(Filtered, LastSampleTime, TargetTime, OutHand);
+}
+
+bool FHandTrackingPosePredictor::Advance(const FHandFrame& Hand, double SampleTime, double TargetTime, FHandFrame& OutHand) const
+{
+	if (!bHasState)
+	{
+		return false;
+	}
+
+	// x + v h + a h^2 / 2. 예측을 끄면 들어온 손을 그대로 낸다.
+	const float Horizon = Params.bPredict ? static_cast<float>(FMath::Clamp(TargetTime - SampleTime, 0.0, static_cast<double>(Params.MaxPredictionHorizon))) : 0.0f;
+	const VectorRegister4Float H = VectorSetFloat1(Horizon);
+	const VectorRegister4Float HalfH2 = VectorSetFloat1(0.5f * Horizon * Horizon);
+
+	auto Extrapolate = [&H, &HalfH2](const float* Position, const float* Velocity, const float* Acceleration, float* Out)
+	{
+		for (int32 Base = 0; Base < FHandFrame::PaddedLandmarkCount; Base += 4)
+		{
+			const VectorRegister4Float Result = VectorMultiplyAdd(VectorLoad(Acceleration + Base), HalfH2,
+				VectorMultiplyAdd(VectorLoad(Velocity + Base), H, VectorLoad(Position + Base)));
+			VectorStore(Result, Out + Base);
+		}
+	};
+	Extrapolate(Hand.X, VelocityX, AccelerationX, OutHand.X);
+	Extrapolate(Hand.Y, VelocityY, AccelerationY, OutHand.Y);
+	Extrapolate(Hand.Z, VelocityZ, AccelerationZ, OutHand.Z);
+
+	if (&OutHand != &Hand)
+	{
+		OutHand.Handedness = Hand.Handedness;
+		OutHand.ValidMask = Hand.ValidMask;
+		FMemory::Memcpy(OutHand.Confidence, Hand.Confidence, sizeof(OutHand.Confidence));
+	}
+	return true;
+}
+
+void FHandTrackingPosePredictor::Reset()
+{
+	Filtered.Reset(Filtered.Handedness);
+	FMemory::Memzero(VelocityX);
+	FMemory::Memzero(VelocityY);
+	FMemory::Memzero(VelocityZ);
+	FMemory::Memzero(AccelerationX);
+	FMemory::Memzero(AccelerationY);
+	FMemory::Memzero(AccelerationZ);
+	LastSampleTime = 0.0;
+	bHasState = false;
+}
@@ -0,0 +1,456 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingProtocol.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/StringBuilder.h"
+#include "HandTracking/HandTrackingCompactCodec.h"
+#include "HandTracking/HandTrackingJsonParser.h"
+#include "HandTracking/HandTrackingStats.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Hand tracking binary frames are little-endian.");
+
+namespace HandTrackingProtocol
+{
+	namespace
+	{
+		template <typename T>
+		FORCEINLINE T ReadValue(const uint8* Data)
+		{
+			T Value;
+			FMemory::Memcpy(&Value, Data, sizeof(T));
+			return Value;
+		}
+
+		template <typename T>
+		FORCEINLINE void WriteValue(uint8* Data, T Value)
+		{
+			FMemory::Memcpy(Data, &Value, sizeof(T));
+		}
+
+		bool ParseJsonFrameWithSerializer(const FString& Json, FHandTrackingFrame& OutFrame)
+		{
+			TSharedPtr<FJsonObject> JsonObject;
+			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+			if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+			{
+				return false;
+			}
+
+			const TArray<TSharedPtr<FJsonValue>>* HandsArray;
+			if (!JsonObject->TryGetArrayField(TEXT("hands"), HandsArray))
+			{
+				return false;
+			}
+
+			OutFrame.Reset();
+			JsonObject->TryGetNumberField(TEXT("timestamp"), OutFrame.CaptureTimestamp);
+
+			for (const auto& HandValue : *HandsArray)
+			{
+				if (OutFrame.NumHands >= MaxTrackedHands)
+				{
+					break;
+				}
+
+				const TSharedPtr<FJsonObject>* HandObject;
+				if (!HandValue->TryGetObject(HandObject))
+				{
+					continue;
+				}
+
+				FString HandType;
+				const TArray<TSharedPtr<FJsonValue>>* Landmarks;
+				if (!(*HandObject)->TryGetStringField(TEXT("type"), HandType) || !(*HandObject)->TryGetArrayField(TEXT("landmarks"), Landmarks))
+				{
+					continue;
+				}
+
+				EHandedness Handedness;
+				if (HandType.Equals(TEXT("Left"), ESearchCase::IgnoreCase))
+				{
+					Handedness = EHandedness::Left;
+				}
+				else if (HandType.Equals(TEXT("Right"), ESearchCase::IgnoreCase))
+				{
+					Handedness = EHandedness::Right;
+				}
+				else
+				{
+					continue;
+				}
+
+				FHandFrame& Hand = OutFrame.Hands[OutFrame.NumHands++];
+				Hand.Reset(Handedness);
+
+				for (const auto& Landmark : *Landmarks)
+				{
+					const TSharedPtr<FJsonObject> LandmarkObj = Landmark->AsObject();
+					if (!LandmarkObj.IsValid())
+					{
+						continue;
+					}
+
+					const int32 Id = LandmarkObj->GetIntegerField(TEXT("id"));
+					if (Id >= 0 && Id < HandLandmarkCount)
+					{
+						Hand.SetLandmark(Id,
+							LandmarkObj->GetNumberField(TEXT("x")),
+							LandmarkObj->GetNumberField(TEXT("y")),
+							LandmarkObj->GetNumberField(TEXT("z")));
+					}
+				}
+			}
+
+			return true;
+		}
+	}
+
+	bool DecodeBinaryFrame(const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame)
+	{
+		if (Data == nullptr || Size < BinaryHeaderSize)
+		{
+			return false;
+		}
+
+		const uint32 FrameSize = ReadValue<uint32>(Data);
+		const uint16 Magic = ReadValue<uint16>(Data + 4);
+		const uint8 Version = Data[6];
+		const uint8 HandCount = Data[7];
+
+		if (Magic != BinaryMagic || Version != BinaryVersion || HandCount > MaxTrackedHands)
+		{
+			return false;
+		}
+		if (FrameSize != static_cast<uint32>(BinaryHeaderSize + HandCount * BinaryHandSize) || static_cast<uint32>(Size) < FrameSize)
+		{
+			return false;
+		}
+
+		OutFrame.CaptureTimestamp = static_cast<double>(ReadValue<uint64>(Data + 8)) * 1.0e-6;
+		OutFrame.NumHands = 0;
+
+		const uint8* HandData = Data + BinaryHeaderSize;
+		for (int32 HandIndex = 0; HandIndex < HandCount; ++HandIndex, HandData += BinaryHandSize)
+		{
+			if (HandData[0] > static_cast<uint8>(EHandedness::Right))
+			{
+				continue;
+			}
+
+			FHandFrame& Hand = OutFrame.Hands[OutFrame.NumHands++];
+			Hand.Handedness = static_cast<EHandedness>(HandData[0]);
+			Hand.ValidMask = FHandFrame::AllLandmarksMask;
+			// 와이어는 x, y, z가 번갈아 나오므로 성분별 배열로 풀어 넣는다.
+			const uint8* LandmarkData = HandData + 4;
+			for (int32 Id = 0; Id < HandLandmarkCount; ++Id, LandmarkData += 3 * sizeof(float))
+			{
+				Hand.X[Id] = ReadValue<float>(LandmarkData);
+				Hand.Y[Id] = ReadValue<float>(LandmarkData + 4);
+				Hand.Z[Id] = ReadValue<float>(LandmarkData + 8);
+				Hand.Confidence[Id] = 1.0f;
+			}
+		}
+
+		return true;
+	}
+
+	int32 EncodeBinaryFrame(const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes)
+	{
+		const int32 NumHands = FMath::Clamp(Frame.NumHands, 0, MaxTrackedHands);
+		const int32 FrameSize = BinaryHeaderSize + NumHands * BinaryHandSize;
+
+		const int32 StartOffset = OutBytes.AddZeroed(FrameSize);
+		uint8* Data = OutBytes.GetData() + StartOffset;
+
+		WriteValue<uint32>(Data, FrameSize);
+		WriteValue<uint16>(Data + 4, BinaryMagic);
+		Data[6] = BinaryVersion;
+		Data[7] = static_cast<uint8>(NumHands);
+		WriteValue<uint64>(Data + 8, static_cast<uint64>(FMath::Max(Frame.CaptureTimestamp, 0.0) * 1.0e6));
+
+		uint8* HandData = Data + BinaryHeaderSize;
+		for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex, HandData += BinaryHandSize)
+		{
+			const FHandFrame& Hand = Frame.Hands[HandIndex];
+			HandData[0] = static_cast<uint8>(Hand.Handedness);
+			// 빠진 랜드마크는 값이 0이므로 그대로 써도 된다.
+			uint8* LandmarkData = HandData + 4;
+			for (int32 Id = 0; Id < HandLandmarkCount; ++Id, LandmarkData += 3 * sizeof(float))
+			{
+				WriteValue<float>(LandmarkData, Hand.X[Id]);
+				WriteValue<float>(LandmarkData + 4, Hand.Y[Id]);
+				WriteValue<float>(LandmarkData + 8, Hand.Z[Id]);
+			}
+		}
+
+		return FrameSize;
+	}
+
+	int32 EncodeJsonFrame(const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes)
+	{
+		// 파이썬 트래커와 같은 필드 순서. 손 두 개면 4KB 남짓이라 스택 버퍼로 충분하다.
+		TAnsiStringBuilder<8192> Builder;
+		Builder.Appendf("{\"timestamp\":%.6f,\"hands\":[", Frame.CaptureTimestamp);
+
+		const int32 NumHands = FMath::Clamp(Frame.NumHands, 0, MaxTrackedHands);
+		for (int32 HandIndex = 0; HandIndex < NumHands; ++HandIndex)
+		{
+			const FHandFrame& Hand = Frame.Hands[HandIndex];
+			Builder.Appendf("%s{\"type\":\"%s\",\"landmarks\":[", HandIndex > 0 ? "," : "", Hand.Handedness == EHandedness::Left ? "Left" : "Right");
+
+			// 들어온 랜드마크만 보낸다.
+			bool bFirstLandmark = true;
+			for (int32 Id = 0; Id < HandLandmarkCount; ++Id)
+			{
+				if (Hand.IsLandmarkValid(Id))
+				{
+					Builder.Appendf("%s{\"id\":%d,\"x\":%.6f,\"y\":%.6f,\"z\":%.6f}", bFirstLandmark ? "" : ",", Id, Hand.X[Id], Hand.Y[Id], Hand.Z[Id]);
+					bFirstLandmark = false;
+				}
+			}
+			Builder.Append("]}");
+		}
+		Builder.Append("]}");
+
+		OutBytes.Append(reinterpret_cast<const uint8*>(Builder.GetData()), Builder.Len());
+		return Builder.Len();
+	}
+
+	int32 EncodeFrame(EHandTrackingWireFormat Format, const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes)
+	{
+		switch (Format)
+		{
+		case EHandTrackingWireFormat::Binary:
+			return EncodeBinaryFrame(Frame, OutBytes);
+		case EHandTrackingWireFormat::Compact:
+			return HandTrackingCompactCodec::EncodeKeyframe(Frame, 0, FHandTrackingCompactEncoderSettings().FractionBits, OutBytes);
+		case EHandTrackingWireFormat::Json:
+		default:
+			return EncodeJsonFrame(Frame, OutBytes);
+		}
+	}
+
+	bool ParseJsonFrame(const FString& Json, FHandTrackingFrame& OutFrame)
+	{
+		HANDTRACKING_SCOPE(Parse);
+		return HandTrackingJsonParser::TryParseFrame(*Json, Json.Len(), OutFrame) || ParseJsonFrameWithSerializer(Json, OutFrame);
+	}
+
+	bool DecodeFrame(EHandTrackingWireFormat Format, const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame)
+	{
+		HANDTRACKING_SCOPE(Parse);
+		switch (Format)
+		{
+		case EHandTrackingWireFormat::Binary:
+			return DecodeBinaryFrame(Data, Size, OutFrame);
+		case EHandTrackingWireFormat::Compact:
+			return HandTrackingCompactCodec::DecodeFrame(Data, Size, OutFrame);
+		case EHandTrackingWireFormat::Json:
+		default:
+			{
+				// 수신 버퍼의 UTF-8을 그대로 파싱한다. 형식이 다를 때만 FString으로 변환해 범용 파서에 맡긴다.
+				if (HandTrackingJsonParser::TryParseFrame(reinterpret_cast<const ANSICHAR*>(Data), Size, OutFrame))
+				{
+					return true;
+				}
+				FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data), Size);
+				return ParseJsonFrameWithSerializer(FString(Converted.Length(), Converted.Get()), OutFrame);
+			}
+		}
+	}
+
+	bool DecodeTransportFrame(EHandTrackingTransport Transport, EHandTrackingWireFormat Format, const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame)
+	{
+		// UDP 프레임은 앞의 데이터그램 헤더에서 시퀀스와 캡처 시각을 읽는다.
+		uint32 Sequence = 0;
+		uint64 CaptureTimeUs = 0;
+		if (Transport == EHandTrackingTransport::Udp)
+		{
+			if (!ReadDatagramHeader(Data, Size, Sequence, CaptureTimeUs))
+			{
+				return false;
+			}
+			Data += DatagramHeaderSize;
+			Size -= DatagramHeaderSize;
+		}
+
+		// 바이너리 형식은 수신 버퍼에서 바로 디코딩한다.
+		if (!DecodeFrame(Format, Data, Size, OutFrame))
+		{
+			return false;
+		}
+
+		if (Transport == EHandTrackingTransport::Udp)
+		{
+			OutFrame.Sequence = Sequence;
+			OutFrame.CaptureTimestamp = static_cast<double>(CaptureTimeUs) * 1.0e-6;
+		}
+		return true;
+	}
+
+	bool ReadDatagramHeader(const uint8* Data, int32 Size, uint32& OutSequence, uint64& OutCaptureTimeUs)
+	{
+		if (Data == nullptr || Size < DatagramHeaderSize || ReadValue<uint32>(Data) != DatagramMagic)
+		{
+			return false;
+		}
+
+		OutSequence = ReadValue<uint32>(Data + 4);
+		OutCaptureTimeUs = ReadValue<uint64>(Data + 8);
+		return true;
+	}
+
+	void WriteDatagramHeader(TArray<uint8>& OutBytes, uint32 Sequence, uint64 CaptureTimeUs)
+	{
+		const int32 StartOffset = OutBytes.AddUninitialized(DatagramHeaderSize);
+		uint8* Data = OutBytes.GetData() + StartOffset;
+		WriteValue<uint32>(Data, DatagramMagic);
+		WriteValue<uint32>(Data + 4, Sequence);
+		WriteValue<uint64>(Data + 8, CaptureTimeUs);
+	}
+
+	int32 EncodeControlMessage(const FHandTrackingControlMessage& Message, TArray<uint8>& OutBytes)
+	{
+		TAnsiStringBuilder<256> Builder;
+		Builder.Appendf("{\"type\":\"control\",\"seq\":%u,\"rate\":%.1f,\"headroom\":%.3f,\"hands\":[", Message.Sequence, Message.RequestedRate, Message.Headroom);
+
+		bool bFirstHand = true;
+		for (int32 HandIndex = 0; HandIndex < MaxTrackedHands; ++HandIndex)
+		{
+			if (Message.HandMask & (1u << HandIndex))
+			{
+				Builder.Appendf("%s\"%s\"", bFirstHand ? "" : ",", HandIndex == static_cast<int32>(EHandedness::Left) ? "Left" : "Right");
+				bFirstHand = false;
+			}
+		}
+		Builder.Append("]");
+
+		if (Message.bHasRegionOfInterest)
+		{
+			const FBox2f& Region = Message.RegionOfInterest;
+			Builder.Appendf(",\"roi\":[%.3f,%.3f,%.3f,%.3f]", Region.Min.X, Region.Min.Y, Region.Max.X, Region.Max.Y);
+		}
+		Builder.Append("}\n");
+
+		OutBytes.Append(reinterpret_cast<const uint8*>(Builder.GetData()), Builder.Len());
+		return Builder.Len();
+	}
+
+	bool ParseControlMessage(const FString& Json, FHandTrackingControlMessage& OutMessage)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		FString Type;
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid()
+			|| !JsonObject->TryGetStringField(TEXT("type"), Type) || Type != TEXT("control"))
+		{
+			return false;
+		}
+
+		OutMessage = FHandTrackingControlMessage();
+		JsonObject->TryGetNumberField(TEXT("seq"), OutMessage.Sequence);
+		double Rate = 0.0;
+		double Headroom = 0.0;
+		JsonObject->TryGetNumberField(TEXT("rate"), Rate);
+		JsonObject->TryGetNumberField(TEXT("headroom"), Headroom);
+		OutMessage.RequestedRate = static_cast<float>(Rate);
+		OutMessage.Headroom = static_cast<float>(Headroom);
+
+		const TArray<TSharedPtr<FJsonValue>>* Hands;
+		if (JsonObject->TryGetArrayField(TEXT("hands"), Hands))
+		{
+			OutMessage.HandMask = 0;
+			for (const TSharedPtr<FJsonValue>& Hand : *Hands)
+			{
+				const FString HandName = Hand->AsString();
+				if (HandName.Equals(TEXT("Left"), ESearchCase::IgnoreCase))
+				{
+					OutMessage.HandMask |= 1u << static_cast<int32>(EHandedness::Left);
+				}
+				else if (HandName.Equals(TEXT("Right"), ESearchCase::IgnoreCase))
+				{
+					OutMessage.HandMask |= 1u << static_cast<int32>(EHandedness::Right);
+				}
+			}
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Region;
+		if (JsonObject->TryGetArrayField(TEXT("roi"), Region) && Region->Num() == 4)
+		{
+			OutMessage.bHasRegionOfInterest = true;
+			OutMessage.RegionOfInterest = FBox2f(
+				FVector2f((*Region)[0]->AsNumber(), (*Region)[1]->AsNumber()),
+				FVector2f((*Region)[2]->AsNumber(), (*Region)[3]->AsNumber()));
+		}
+		return true;
+	}
+
+	int32 EncodePing(uint32 Sequence, uint64 PingTimeUs, TArray<uint8>& OutBytes)
+	{
+		TAnsiStringBuilder<64> Builder;
+		Builder.Appendf("{\"type\":\"ping\",\"seq\":%u,\"t0\":%llu}\n", Sequence, static_cast<unsigned long long>(PingTimeUs));
+		OutBytes.Append(reinterpret_cast<const uint8*>(Builder.GetData()), Builder.Len());
+		return Builder.Len();
+	}
+
+	bool ParsePing(const FString& Json, uint32& OutSequence, uint64& OutPingTimeUs)
+	{
+		TSharedPtr<FJsonObject> JsonObject;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		FString Type;
+		double PingTimeUs = 0.0;
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid()
+			|| !JsonObject->TryGetStringField(TEXT("type"), Type) || Type != TEXT("ping")
+			|| !JsonObject->TryGetNumberField(TEXT("t0"), PingTimeUs))
+		{
+			return false;
+		}
+
+		OutSequence = 0;
+		JsonObject->TryGetNumberField(TEXT("seq"), OutSequence);
+		// 마이크로초 값은 2^53보다 한참 작아 double로 읽어도 정확하다.
+		OutPingTimeUs = static_cast<uint64>(PingTimeUs);
+		return true;
+	}
+
+	bool DecodeClockReply(const uint8* Data, int32 Size, FHandTrackingClockReply& OutReply)
+	{
+		if (Data == nullptr || Size != ClockFrameSize
+			|| ReadValue<uint32>(Data) != ClockFrameSize
+			|| ReadValue<uint16>(Data + 4) != ClockMagic
+			|| Data[6] != ClockVersion)
+		{
+			return false;
+		}
+
+		OutReply.Sequence = ReadValue<uint32>(Data + 8);
+		OutReply.PingTimeUs = ReadValue<uint64>(Data + 12);
+		OutReply.TrackerReceiveTimeUs = ReadValue<uint64>(Data + 20);
+		OutReply.TrackerSendTimeUs = ReadValue<uint64>(Data + 28);
+		return true;
+	}
+
+	int32 EncodeClockReply(const FHandTrackingClockReply& Reply, TArray<uint8>& OutBytes)
+	{
+		const int32 StartOffset = OutBytes.AddUninitialized(ClockFrameSize);
+		uint8* Data = OutBytes.GetData() + StartOffset;
+		WriteValue<uint32>(Data, ClockFrameSize);
+		WriteValue<uint16>(Data + 4, ClockMagic);
+		Data[6] = ClockVersion;
+		Data[7] = 0;
+		WriteValue<uint32>(Data + 8, Reply.Sequence);
+		WriteValue<uint64>(Data + 12, Reply.PingTimeUs);
+		WriteValue<uint64>(Data + 20, Reply.TrackerReceiveTimeUs);
+		WriteValue<uint64>(Data + 28, Reply.TrackerSendTimeUs);
+		return ClockFrameSize;
+	}
+
+	const TCHAR* GetHandednessName(EHandedness Handedness)
+	{
+		return Handedness == EHandedness::Left ? TEXT("Left") : TEXT("Right");
+	}
+}
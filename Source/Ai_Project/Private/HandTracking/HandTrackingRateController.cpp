@@ -0,0 +1,179 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingRateController.h"
+
+#include "HandTracking/HandTrackingSettings.h"
+
+namespace
+{
+	// 관심 영역 모서리가 이보다 많이 움직였을 때만 새로 알린다 (정규화 좌표).
+	constexpr float RegionMoveThreshold = 0.05f;
+	// 요청 주기가 이보다 적게 바뀌었으면 보내지 않는다(Hz).
+	constexpr float RateChangeThreshold = 0.5f;
+}
+
+FHandTrackingRateControlParams FHandTrackingRateControlParams::FromSettings()
+{
+	const UHandTrackingSettings* Settings = GetDefault<UHandTrackingSettings>();
+
+	FHandTrackingRateControlParams Params;
+	Params.TargetFrameRate = Settings->RateControlTargetFrameRate;
+	Params.MinRate = Settings->MinTrackerRate;
+	Params.MaxRate = FMath::Max(Settings->MaxTrackerRate, Settings->MinTrackerRate);
+	Params.InitialRate = FMath::Clamp(Settings->InitialTrackerRate, Params.MinRate, Params.MaxRate);
+	Params.LowHeadroom = Settings->LowHeadroom;
+	Params.HighHeadroom = FMath::Max(Settings->HighHeadroom, Settings->LowHeadroom);
+	Params.DecreaseFactor = Settings->RateDecreaseFactor;
+	Params.IncreaseStep = Settings->RateIncreaseStep;
+	Params.IncreaseHoldTime = Settings->RateIncreaseHoldTime;
+	Params.ControlInterval = Settings->ControlInterval;
+	Params.KeepAliveInterval = FMath::Max(Settings->ControlKeepAliveInterval, Settings->ControlInterval);
+	Params.RegionOfInterestMargin = Settings->RegionOfInterestMargin;
+	Params.TrackerImageSize = FVector2f(FMath::Max(Settings->TrackerImageSize.X, 1.0), FMath::Max(Settings->TrackerImageSize.Y, 1.0));
+	return Params;
+}
+
+FHandTrackingRateController::FHandTrackingRateController()
+{
+	SetParams(FHandTrackingRateControlParams());
+}
+
+void FHandTrackingRateController::SetParams(const FHandTrackingRateControlParams& InParams)
+{
+	Params = InParams;
+	RequestedRate = FMath::Clamp(Params.InitialRate, Params.MinRate, Params.MaxRate);
+	bHasHeadroom = false;
+	HighHeadroomSince = -1.0;
+	bHasSent = false;
+}
+
+void FHandTrackingRateController::ObserveFrame(const FHandTrackingFrame& Frame, uint8 HandMask)
+{
+	FBox2f Bounds(ForceInit);
+	for (int32 HandIndex = 0; HandIndex < Frame.NumHands; ++HandIndex)
+	{
+		const FHandFrame& Hand = Frame.Hands[HandIndex];
+		if ((HandMask & (1u << static_cast<int32>(Hand.Handedness))) == 0)
+		{
+			continue;
+		}
+		for (uint32 Bits = Hand.ValidMask; Bits != 0; Bits &= Bits - 1)
+		{
+			const int32 Id = static_cast<int32>(FMath::CountTrailingZeros(Bits));
+			Bounds += FVector2f(Hand.X[Id] / Params.TrackerImageSize.X, Hand.Y[Id] / Params.TrackerImageSize.Y);
+		}
+	}
+
+	bHasRegion = Bounds.bIsValid != 0;
+	if (bHasRegion)
+	{
+		// 손이 화면에서 움직일 만큼 넓힌다. 손 하나짜리 작은 상자도 같은 비율로 넓어지도록 긴 변 기준
+		const FVector2f Size = Bounds.GetSize();
+		const float Margin = FMath::Max(Size.X, Size.Y) * Params.RegionOfInterestMargin;
+		Region.Min = FVector2f(FMath::Clamp(Bounds.Min.X - Margin, 0.0f, 1.0f), FMath::Clamp(Bounds.Min.Y - Margin, 0.0f, 1.0f));
+		Region.Max = FVector2f(FMath::Clamp(Bounds.Max.X + Margin, 0.0f, 1.0f), FMath::Clamp(Bounds.Max.Y + Margin, 0.0f, 1.0f));
+		Region.bIsValid = 1;
+	}
+}
+
+bool FHandTrackingRateController::Update(double Now, float FrameSeconds, uint8 HandMask, FHandTrackingControlMessage& OutMessage)
+{
+	UpdateRate(Now, FrameSeconds);
+	if (!ShouldSend(Now, HandMask))
+	{
+		return false;
+	}
+
+	OutMessage.Sequence = ++Sequence;
+	OutMessage.RequestedRate = RequestedRate;
+	OutMessage.Headroom = SmoothedHeadroom;
+	OutMessage.HandMask = HandMask;
+	OutMessage.bHasRegionOfInterest = bHasRegion;
+	OutMessage.RegionOfInterest = Region;
+
+	LastSent = OutMessage;
+	LastSendTime = Now;
+	bHasSent = true;
+	return true;
+}
+
+void FHandTrackingRateController::UpdateRate(double Now, float FrameSeconds)
+{
+	const float Headroom = 1.0f - FrameSeconds * Params.TargetFrameRate;
+	if (!bHasHeadroom)
+	{
+		SmoothedHeadroom = Headroom;
+		bHasHeadroom = true;
+		LastRateChangeTime = Now;
+	}
+	else
+	{
+		// 한 프레임 튀는 것에는 반응하지 않는다.
+		const float Alpha = 1.0f - FMath::Exp(-static_cast<float>(Now - LastUpdateTime) / Params.HeadroomTimeConstant);
+		SmoothedHeadroom += Alpha * (Headroom - SmoothedHeadroom);
+	}
+	LastUpdateTime = Now;
+
+	const double SinceRateChange = Now - LastRateChangeTime;
+	if (SmoothedHeadroom < Params.LowHeadroom)
+	{
+		// 예산을 넘기면 받은 뒤 버리지 말고 덜 받는다. 줄인 효과가 평활한 여유에 보일 때까지 한 제어 간격은 기다린다.
+		HighHeadroomSince = -1.0;
+		const float NewRate = FMath::Max(RequestedRate * Params.DecreaseFactor, Params.MinRate);
+		if (SinceRateChange >= Params.ControlInterval && NewRate < RequestedRate)
+		{
+			RequestedRate = NewRate;
+			LastRateChangeTime = Now;
+		}
+	}
+	else if (SmoothedHeadroom > Params.HighHeadroom)
+	{
+		if (HighHeadroomSince < 0.0)
+		{
+			HighHeadroomSince = Now;
+		}
+		const float NewRate = FMath::Min(RequestedRate + Params.IncreaseStep, Params.MaxRate);
+		if (Now - HighHeadroomSince >= Params.IncreaseHoldTime && SinceRateChange >= Params.IncreaseHoldTime && NewRate > RequestedRate)
+		{
+			RequestedRate = NewRate;
+			LastRateChangeTime = Now;
+		}
+	}
+	else
+	{
+		HighHeadroomSince = -1.0;
+	}
+}
+
+bool FHandTrackingRateController::ShouldSend(double Now, uint8 HandMask) const
+{
+	if (!bHasSent)
+	{
+		return true;
+	}
+
+	const double SinceSend = Now - LastSendTime;
+	if (SinceSend >= Params.KeepAliveInterval)
+	{
+		return true;
+	}
+	if (SinceSend < Params.ControlInterval)
+	{
+		return false;
+	}
+
+	if (FMath::Abs(RequestedRate - LastSent.RequestedRate) >= RateChangeThreshold || HandMask != LastSent.HandMask || bHasRegion != LastSent.bHasRegionOfInterest)
+	{
+		return true;
+	}
+	if (bHasRegion)
+	{
+		const FBox2f& Sent = LastSent.RegionOfInterest;
+		const float Moved = FMath::Max(
+			FMath::Max(FMath::Abs(Region.Min.X - Sent.Min.X), FMath::Abs(Region.Min.Y - Sent.Min.Y)),
+			FMath::Max(FMath::Abs(Region.Max.X - Sent.Max.X), FMath::Abs(Region.Max.Y - Sent.Max.Y)));
+		return Moved > RegionMoveThreshold;
+	}
+	return false;
+}
@@ -0,0 +1,535 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingReceiveWorker.h"
+
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/UdpSocketBuilder.h"
+#include "Misc/ScopeLock.h"
+#include "HandTracking/HandTrackingIoThread.h"
+#include "HandTracking/HandTrackingProtocol.h"
+#include "HandTracking/HandTrackingStats.h"
+
+FHandTrackingReceiveWorker::FHandTrackingReceiveWorker(const FHandTrackingReceiveWorkerSettings& InSettings, FConnectionStateCallback InOnConnectionStateChanged)
+	: Settings(InSettings)
+	, OnConnectionStateChanged(MoveTemp(InOnConnectionStateChanged))
+	, Reassembler(InSettings.WireFormat)
+{
+	ReceiveBuffer.SetNumUninitialized(ReceiveBufferSize);
+	FrameQueue.SetRecorder(Settings.Recorder);
+}
+
+FHandTrackingReceiveWorker::~FHandTrackingReceiveWorker()
+{
+	Shutdown();
+}
+
+bool FHandTrackingReceiveWorker::Start()
+{
+	if (IoThread.IsValid())
+	{
+		return false;
+	}
+
+	Phase = EPhase::WaitingToConnect;
+	NextAttemptTime = 0.0;
+	ReconnectDelay = Settings.InitialReconnectDelaySeconds;
+	IoThread = FHandTrackingIoThread::Acquire();
+	if (!IoThread.IsValid())
+	{
+		return false;
+	}
+	IoThread->Register(this);
+	return true;
+}
+
+void FHandTrackingReceiveWorker::Shutdown()
+{
+	if (IoThread.IsValid())
+	{
+		// 돌아오면 I/O 스레드가 이 워커를 더 이상 부르지 않으므로 소켓을 여기서 닫아도 된다.
+		IoThread->Unregister(this);
+		IoThread.Reset();
+		CloseSocket();
+		SetConnectionState(EHandTrackingConnectionState::Disconnected);
+	}
+}
+
+bool FHandTrackingReceiveWorker::PopLatestFrame(FHandTrackingRawFrame& OutFrame)
+{
+	return FrameQueue.PopLatest(OutFrame);
+}
+
+FHandTrackingReceiveStats FHandTrackingReceiveWorker::GetStats() const
+{
+	FHandTrackingReceiveStats Stats;
+	Stats.DroppedFrames = static_cast<int32>(FrameQueue.GetDroppedFrameCount());
+	Stats.LostPackets = static_cast<int32>(LostPacketCount.load(std::memory_order_relaxed));
+	Stats.ReorderedPackets = static_cast<int32>(ReorderedPacketCount.load(std::memory_order_relaxed));
+	Stats.DuplicatePackets = static_cast<int32>(DuplicatePacketCount.load(std::memory_order_relaxed));
+	Stats.Reconnects = static_cast<int32>(ReconnectCount.load(std::memory_order_relaxed));
+	return Stats;
+}
+
+bool FHandTrackingReceiveWorker::Send(TArray<uint8>&& Data)
+{
+	if (GetConnectionState() != EHandTrackingConnectionState::Connected)
+	{
+		return false;
+	}
+
+	// 실제 전송은 I/O 스레드가 소켓을 쓸 수 있을 때 처리한다.
+	OutgoingQueue.Enqueue(MoveTemp(Data));
+	if (IoThread.IsValid())
+	{
+		IoThread->Wake();
+	}
+	return true;
+}
+
+EHandTrackingConnectionState FHandTrackingReceiveWorker::GetConnectionState() const
+{
+	return ConnectionState.load(std::memory_order_relaxed);
+}
+
+FHandTrackingClockEstimate FHandTrackingReceiveWorker::GetClockEstimate() const
+{
+	FScopeLock Lock(&ClockEstimateLock);
+	return PublishedClockEstimate;
+}
+
+bool FHandTrackingReceiveWorker::Service(double Now)
+{
+	switch (Phase)
+	{
+	case EPhase::WaitingToConnect:
+		if (Now < NextAttemptTime)
+		{
+			return false;
+		}
+		SetConnectionState(EHandTrackingConnectionState::Connecting);
+		if (!OpenSocket())
+		{
+			// 트래커가 아직 안 떴거나 재시작 중이다. 점점 간격을 늘려 다시 시도
+			ScheduleReconnect(Now);
+		}
+		else
+		{
+			Phase = EPhase::Connecting;
+			ConnectDeadline = Now + Settings.ConnectTimeoutSeconds;
+		}
+		return true;
+
+	case EPhase::Connecting:
+		if (Settings.Transport == EHandTrackingTransport::Udp)
+		{
+			// UDP는 바인딩만으로는 트래커가 살아 있는지 모른다. 첫 데이터그램이 와야 붙은 것으로 본다.
+			const bool bReadable = Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::Zero());
+			if (bReadable)
+			{
+				ReceiveDatagrams();
+			}
+			if (LastDatagramTime > 0.0)
+			{
+				OnSocketConnected();
+				return true;
+			}
+			if (Now >= ConnectDeadline)
+			{
+				CloseSocket();
+				ScheduleReconnect(Now);
+				return true;
+			}
+			return bReadable;
+		}
+		// 논블로킹 접속은 소켓이 쓰기 가능해지면 끝난다.
+		if (Socket->Wait(ESocketWaitConditions::WaitForWrite, FTimespan::Zero()) && Socket->GetConnectionState() == ESocketConnectionState::SCS_Connected)
+		{
+			OnSocketConnected();
+			return true;
+		}
+		// 거부된 접속은 제한 시간까지 기다리지 않고 바로 백오프에 들어간다.
+		if (Socket->GetConnectionState() == ESocketConnectionState::SCS_ConnectionError || Now >= ConnectDeadline)
+		{
+			CloseSocket();
+			ScheduleReconnect(Now);
+			return true;
+		}
+		return false;
+
+	case EPhase::Connected:
+	{
+		FrameQueue.FlushPending();
+
+		bool bDidWork = false;
+		SendPingIfDue(Now);
+		bool bStillConnected = FlushOutgoing();
+		if (bStillConnected && Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::Zero()))
+		{
+			bStillConnected = (Settings.Transport == EHandTrackingTransport::Udp) ? ReceiveDatagrams() : ReceiveStream();
+			bDidWork = true;
+		}
+		// UDP는 끊김을 알 수 없으므로 접속 제한 시간 동안 프레임도 시계 응답도 없으면 끊긴 것으로 본다.
+		if (bStillConnected && Settings.Transport == EHandTrackingTransport::Udp && Now - LastDatagramTime > Settings.ConnectTimeoutSeconds)
+		{
+			bStillConnected = false;
+		}
+
+		if (!bStillConnected)
+		{
+			UE_LOG(LogHandTracking, Warning, TEXT("Lost connection to hand tracker on port %d, reconnecting."), Settings.Port);
+			CloseSocket();
+			SetConnectionState(EHandTrackingConnectionState::Disconnected);
+			// 끊긴 직후에는 바로 한 번 다시 붙어 본다.
+			Phase = EPhase::WaitingToConnect;
+			NextAttemptTime = Now;
+			bDidWork = true;
+		}
+		return bDidWork;
+	}
+	}
+	return false;
+}
+
+void FHandTrackingReceiveWorker::OnSocketConnected()
+{
+	if (bHasConnected)
+	{
+		ReconnectCount.fetch_add(1, std::memory_order_relaxed);
+	}
+	bHasConnected = true;
+	ReconnectDelay = Settings.InitialReconnectDelaySeconds;
+	Phase = EPhase::Connected;
+	// 다시 뜬 트래커는 시계 기준이 다를 수 있다.
+	ResetClockSync();
+	if (Settings.Transport == EHandTrackingTransport::Tcp)
+	{
+		UE_LOG(LogHandTracking, Log, TEXT("Connected to server!"));
+	}
+	else
+	{
+		UE_LOG(LogHandTracking, Log, TEXT("Receiving hand tracking datagrams on port %d."), Settings.Port);
+	}
+	SetConnectionState(EHandTrackingConnectionState::Connected);
+}
+
+void FHandTrackingReceiveWorker::ScheduleReconnect(double Now)
+{
+	SetConnectionState(EHandTrackingConnectionState::Disconnected);
+	Phase = EPhase::WaitingToConnect;
+	NextAttemptTime = Now + ReconnectDelay;
+	ReconnectDelay = FMath::Min(ReconnectDelay * 2.0f, Settings.MaxReconnectDelaySeconds);
+}
+
+bool FHandTrackingReceiveWorker::OpenSocket()
+{
+	return (Settings.Transport == EHandTrackingTransport::Udp) ? BindDatagramSocket() : BeginConnectStreamSocket();
+}
+
+bool FHandTrackingReceiveWorker::BeginConnectStreamSocket()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	if (SocketSubsystem == nullptr)
+	{
+		return false;
+	}
+
+	Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("HandTrackingTcp"), false);
+	if (Socket == nullptr)
+	{
+		return false;
+	}
+
+	// 작은 제어 메시지가 Nagle 알고리즘에 묶여 늦게 나가지 않도록 한다.
+	Socket->SetNonBlocking(true);
+	Socket->SetNoDelay(true);
+
+	RemoteAddr = SocketSubsystem->CreateInternetAddr();
+	RemoteAddr->SetIp(Settings.Address.Value);
+	RemoteAddr->SetPort(Settings.Port);
+
+	if (!Socket->Connect(*RemoteAddr))
+	{
+		const ESocketErrors Error = SocketSubsystem->GetLastErrorCode();
+		if (Error != SE_EINPROGRESS && Error != SE_EWOULDBLOCK)
+		{
+			CloseSocket();
+			return false;
+		}
+	}
+
+	UE_LOG(LogHandTracking, Verbose, TEXT("Connecting to hand tracker %s:%d."), *Settings.Address.ToString(), Settings.Port);
+	Reassembler.Reset();
+	return true;
+}
+
+bool FHandTrackingReceiveWorker::BindDatagramSocket()
+{
+	// 30~120Hz 프레임이 잠깐 밀려도 커널에서 버려지지 않을 만큼 수신 버퍼를 잡는다.
+	Socket = FUdpSocketBuilder(TEXT("HandTrackingUdp"))
+		.AsNonBlocking()
+		.AsReusable()
+		.BoundToAddress(FIPv4Address::Any)
+		.BoundToPort(Settings.Port)
+		.WithReceiveBufferSize(256 * 1024)
+		.Build();
+
+	if (Socket == nullptr)
+	{
+		return false;
+	}
+
+	// 트래커가 어느 포트에서 보내는지는 첫 데이터그램을 받아야 안다. 그 전에 Address:Port로 보내면 이 소켓으로 되돌아온다.
+	RemoteAddr.Reset();
+	LastDatagramTime = 0.0;
+	SenderAddr = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+
+	UE_LOG(LogHandTracking, Log, TEXT("Listening for hand tracking datagrams on port %d."), Settings.Port);
+	SequenceFilter.Reset();
+	KeyframeCache.Reset();
+	return true;
+}
+
+void FHandTrackingReceiveWorker::CloseSocket()
+{
+	if (Socket)
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		Socket = nullptr;
+	}
+
+	// 끊긴 연결로 보내려던 메시지는 의미가 없으므로 버린다.
+	OutgoingQueue.Empty();
+	OutgoingRemainder.Reset();
+}
+
+void FHandTrackingReceiveWorker::SetConnectionState(EHandTrackingConnectionState NewState)
+{
+	const EHandTrackingConnectionState OldState = ConnectionState.exchange(NewState, std::memory_order_relaxed);
+	if (OldState != NewState && OnConnectionStateChanged)
+	{
+		OnConnectionStateChanged(NewState);
+	}
+}
+
+bool FHandTrackingReceiveWorker::ReceiveStream()
+{
+	// 읽기 가능한데 받을 데이터가 없으면 트래커가 연결을 닫은 것이다.
+	uint32 PendingSize = 0;
+	if (!Socket->HasPendingData(PendingSize) || PendingSize == 0)
+	{
+		return false;
+	}
+
+	// 이미 도착해 있는 데이터까지 모두 비운 뒤에 프레임을 잘라낸다.
+	{
+		HANDTRACKING_SCOPE(Receive);
+		do
+		{
+			int32 BytesRead = 0;
+			if (!Socket->Recv(ReceiveBuffer.GetData(), ReceiveBuffer.Num(), BytesRead, ESocketReceiveFlags::None) || BytesRead <= 0)
+			{
+				return false;
+			}
+			Reassembler.Append(ReceiveBuffer.GetData(), BytesRead);
+		}
+		while (Socket->HasPendingData(PendingSize) && PendingSize > 0);
+	}
+	const double ReceiveTime = FPlatformTime::Seconds();
+
+	HANDTRACKING_SCOPE(Reassembly);
+	int32 StaleFrameCount = 0;
+	if (Reassembler.ExtractLatestFrame(ExtractedFrame, StaleFrameCount))
+	{
+		FrameQueue.AddDroppedFrames(StaleFrameCount);
+		FrameQueue.Publish(ExtractedFrame.GetData(), ExtractedFrame.Num());
+	}
+
+	TArray<FHandTrackingClockReply>& ClockReplies = Reassembler.GetClockReplies();
+	for (const FHandTrackingClockReply& Reply : ClockReplies)
+	{
+		HandleClockReply(Reply, ReceiveTime);
+	}
+	ClockReplies.Reset();
+	return true;
+}
+
+bool FHandTrackingReceiveWorker::ReceiveDatagrams()
+{
+	HANDTRACKING_SCOPE(Receive);
+	bool bHasNewFrame = false;
+
+	// 쌓인 데이터그램을 모두 읽고 시퀀스가 가장 앞선 것 하나만 남긴다.
+	uint32 PendingSize = 0;
+	while (Socket->HasPendingData(PendingSize) && PendingSize > 0)
+	{
+		int32 BytesRead = 0;
+		if (!Socket->RecvFrom(ReceiveBuffer.GetData(), ReceiveBuffer.Num(), BytesRead, *SenderAddr, ESocketReceiveFlags::None) || BytesRead <= 0)
+		{
+			break;
+		}
+
+		// 시계 응답은 데이터그램 헤더 없이 온다.
+		FHandTrackingClockReply ClockReply;
+		if (HandTrackingProtocol::DecodeClockReply(ReceiveBuffer.GetData(), BytesRead, ClockReply))
+		{
+			UpdateRemoteAddr();
+			LastDatagramTime = FPlatformTime::Seconds();
+			HandleClockReply(ClockReply, LastDatagramTime);
+			continue;
+		}
+
+		uint32 Sequence = 0;
+		uint64 CaptureTimeUs = 0;
+		if (!HandTrackingProtocol::ReadDatagramHeader(ReceiveBuffer.GetData(), BytesRead, Sequence, CaptureTimeUs))
+		{
+			continue;
+		}
+		UpdateRemoteAddr();
+		LastDatagramTime = FPlatformTime::Seconds();
+		if (SequenceFilter.Accept(Sequence) != FHandTrackingSequenceFilter::EResult::Accepted)
+		{
+			continue;
+		}
+
+		if (Settings.WireFormat == EHandTrackingWireFormat::Compact)
+		{
+			// 최신 데이터그램만 남기기 전에 키프레임을 모두 봐 두어야 뒤따르는 델타를 풀 수 있다.
+			KeyframeCache.Observe(ReceiveBuffer.GetData() + HandTrackingProtocol::DatagramHeaderSize, BytesRead - HandTrackingProtocol::DatagramHeaderSize);
+		}
+
+		if (bHasNewFrame)
+		{
+			FrameQueue.AddDroppedFrames(1);
+		}
+		ExtractedFrame.Reset();
+		ExtractedFrame.Append(ReceiveBuffer.GetData(), BytesRead);
+		bHasNewFrame = true;
+	}
+
+	if (bHasNewFrame && Settings.WireFormat == EHandTrackingWireFormat::Compact)
+	{
+		// 데이터그램 헤더 뒤에 [키프레임][델타]를 붙여 게임 스레드가 혼자 풀 수 있는 프레임으로 만든다.
+		ResolvedFrame.Reset();
+		ResolvedFrame.Append(ExtractedFrame.GetData(), HandTrackingProtocol::DatagramHeaderSize);
+		if (KeyframeCache.Resolve(ExtractedFrame.GetData() + HandTrackingProtocol::DatagramHeaderSize, ExtractedFrame.Num() - HandTrackingProtocol::DatagramHeaderSize, ResolvedFrame))
+		{
+			Swap(ExtractedFrame, ResolvedFrame);
+		}
+		else
+		{
+			FrameQueue.AddDroppedFrames(1);
+			bHasNewFrame = false;
+		}
+	}
+
+	LostPacketCount.store(SequenceFilter.GetLostCount(), std::memory_order_relaxed);
+	ReorderedPacketCount.store(SequenceFilter.GetReorderedCount(), std::memory_order_relaxed);
+	DuplicatePacketCount.store(SequenceFilter.GetDuplicateCount(), std::memory_order_relaxed);
+
+	if (bHasNewFrame)
+	{
+		FrameQueue.Publish(ExtractedFrame.GetData(), ExtractedFrame.Num());
+	}
+
+	// UDP는 연결이 없으므로 끊길 일도 없다.
+	return true;
+}
+
+void FHandTrackingReceiveWorker::UpdateRemoteAddr()
+{
+	// 트래커를 다시 띄우면 송신 포트가 바뀔 수 있으므로 마지막으로 보낸 쪽으로 답한다.
+	if (!RemoteAddr.IsValid() || !(*RemoteAddr == *SenderAddr))
+	{
+		RemoteAddr = SenderAddr->Clone();
+		// 다른 트래커이거나 다시 뜬 트래커이므로 시계도 새로 맞춘다.
+		ResetClockSync();
+		UE_LOG(LogHandTracking, Verbose, TEXT("Sending hand tracking control messages to %s."), *RemoteAddr->ToString(true));
+	}
+}
+
+bool FHandTrackingReceiveWorker::FlushOutgoing()
+{
+	for (;;)
+	{
+		if (OutgoingRemainder.Num() == 0 && !OutgoingQueue.Dequeue(OutgoingRemainder))
+		{
+			return true;
+		}
+
+		int32 BytesSent = 0;
+		if (Settings.Transport == EHandTrackingTransport::Udp)
+		{
+			// 데이터그램은 통째로 가거나 버려진다. 아직 트래커에게서 받은 게 없으면 보낼 곳이 없으므로 버린다.
+			if (RemoteAddr.IsValid())
+			{
+				Socket->SendTo(OutgoingRemainder.GetData(), OutgoingRemainder.Num(), BytesSent, *RemoteAddr);
+			}
+			OutgoingRemainder.Reset();
+			continue;
+		}
+
+		if (!Socket->Send(OutgoingRemainder.GetData(), OutgoingRemainder.Num(), BytesSent))
+		{
+			// 송신 버퍼가 찬 것뿐이면 다음 루프에서 이어서 보낸다.
+			return ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() == SE_EWOULDBLOCK;
+		}
+
+		OutgoingRemainder.RemoveAt(0, BytesSent, false);
+		if (OutgoingRemainder.Num() > 0)
+		{
+			return true;
+		}
+	}
+}
+
+void FHandTrackingReceiveWorker::SendPingIfDue(double Now)
+{
+	if (Settings.ClockSyncInterval <= 0.0f || Now < NextPingTime)
+	{
+		return;
+	}
+	// Udp는 트래커 주소를 알기 전에 보내면 버려지므로 처음 몇 번의 촘촘한 핑을 아껴 둔다.
+	if (Settings.Transport == EHandTrackingTransport::Udp && !RemoteAddr.IsValid())
+	{
+		return;
+	}
+
+	++PingSequence;
+	NextPingTime = Now + ((PingSequence < ClockSyncBurstCount) ? FMath::Min(ClockSyncBurstInterval, Settings.ClockSyncInterval) : Settings.ClockSyncInterval);
+
+	// 대기열에 먼저 와 있는 메시지 뒤에 붙지만 바로 이어서 FlushOutgoing이 보내므로 t0과 실제 송신 사이는 짧다.
+	TArray<uint8> Ping;
+	HandTrackingProtocol::EncodePing(PingSequence, static_cast<uint64>(FPlatformTime::Seconds() * 1.0e6), Ping);
+	OutgoingQueue.Enqueue(MoveTemp(Ping));
+}
+
+void FHandTrackingReceiveWorker::HandleClockReply(const FHandTrackingClockReply& Reply, double ReceiveTime)
+{
+	if (!ClockSync.AddReply(Reply, ReceiveTime))
+	{
+		return;
+	}
+
+	const FHandTrackingClockEstimate& Estimate = ClockSync.GetEstimate();
+	if (Estimate.NumSamples == 1)
+	{
+		UE_LOG(LogHandTracking, Log, TEXT("Hand tracker clock on port %d is %.3f ms ahead of the engine (round trip %.3f ms)."),
+			Settings.Port, Estimate.Offset * 1000.0, Estimate.RoundTrip * 1000.0);
+	}
+
+	FScopeLock Lock(&ClockEstimateLock);
+	PublishedClockEstimate = Estimate;
+}
+
+void FHandTrackingReceiveWorker::ResetClockSync()
+{
+	ClockSync.Reset();
+	NextPingTime = 0.0;
+	PingSequence = 0;
+
+	FScopeLock Lock(&ClockEstimateLock);
+	PublishedClockEstimate = FHandTrackingClockEstimate();
+}
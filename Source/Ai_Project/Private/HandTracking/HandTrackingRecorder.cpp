@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingRecorder.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/ScopeLock.h"
+
+void HandTrackingRecording::WriteHeader(FArchive& Ar, const FHeader& Header)
+{
+	uint32 FileMagic = Magic;
+	uint16 FileVersion = Version;
+	uint8 Transport = static_cast<uint8>(Header.Transport);
+	uint8 WireFormat = static_cast<uint8>(Header.WireFormat);
+	uint64 StartTimeUs = Header.StartTimeUs;
+
+	Ar << FileMagic << FileVersion << Transport << WireFormat << StartTimeUs;
+}
+
+bool HandTrackingRecording::ReadHeader(FArchive& Ar, FHeader& OutHeader)
+{
+	if (Ar.TotalSize() < HeaderSize)
+	{
+		return false;
+	}
+
+	uint32 FileMagic = 0;
+	uint16 FileVersion = 0;
+	uint8 Transport = 0;
+	uint8 WireFormat = 0;
+	Ar << FileMagic << FileVersion << Transport << WireFormat << OutHeader.StartTimeUs;
+
+	if (Ar.IsError() || FileMagic != Magic || FileVersion != Version
+		|| Transport > static_cast<uint8>(EHandTrackingTransport::SharedMemory)
+		|| WireFormat > static_cast<uint8>(EHandTrackingWireFormat::Compact))
+	{
+		return false;
+	}
+
+	OutHeader.Transport = static_cast<EHandTrackingTransport>(Transport);
+	OutHeader.WireFormat = static_cast<EHandTrackingWireFormat>(WireFormat);
+	return true;
+}
+
+TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> FHandTrackingRecorder::Create(const FString& FilePath, EHandTrackingTransport Transport, EHandTrackingWireFormat WireFormat)
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer)
+	{
+		return nullptr;
+	}
+
+	HandTrackingRecording::FHeader Header;
+	Header.Transport = Transport;
+	Header.WireFormat = WireFormat;
+	Header.StartTimeUs = static_cast<uint64>((FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() / ETimespan::TicksPerMicrosecond);
+	HandTrackingRecording::WriteHeader(*Writer, Header);
+
+	return MakeShareable(new FHandTrackingRecorder(MoveTemp(Writer)));
+}
+
+FHandTrackingRecorder::FHandTrackingRecorder(TUniquePtr<FArchive>&& InWriter)
+	: Writer(MoveTemp(InWriter))
+	, LastArrivalTime(FPlatformTime::Seconds())
+{
+}
+
+FHandTrackingRecorder::~FHandTrackingRecorder()
+{
+	if (Writer)
+	{
+		Writer->Close();
+	}
+}
+
+void FHandTrackingRecorder::RecordFrame(const uint8* Data, int32 Size)
+{
+	const double ArrivalTime = FPlatformTime::Seconds();
+
+	FScopeLock Lock(&WriterLock);
+
+	// 절대 시각 대신 앞 프레임과의 간격만 남겨 레코드를 작게 유지한다.
+	uint32 ArrivalDeltaUs = static_cast<uint32>(FMath::Clamp((ArrivalTime - LastArrivalTime) * 1.0e6, 0.0, static_cast<double>(MAX_uint32)));
+	uint32 PayloadSize = static_cast<uint32>(Size);
+	LastArrivalTime = ArrivalTime;
+
+	*Writer << ArrivalDeltaUs << PayloadSize;
+	Writer->Serialize(const_cast<uint8*>(Data), Size);
+	RecordedFrameCount.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,210 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingReplaySource.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HandTracking/HandTrackingStats.h"
+
+namespace
+{
+	// 이보다 가까운 목표 시각은 Sleep 대신 양보하며 기다린다. Sleep 해상도가 1ms 수준이라 간격이 뭉개지지 않도록
+	constexpr double SpinWaitSeconds = 0.002;
+}
+
+FHandTrackingReplaySource::FHandTrackingReplaySource(const FHandTrackingReplaySettings& InSettings, FConnectionStateCallback InOnConnectionStateChanged)
+	: Settings(InSettings)
+	, OnConnectionStateChanged(MoveTemp(InOnConnectionStateChanged))
+{
+}
+
+FHandTrackingReplaySource::~FHandTrackingReplaySource()
+{
+	Shutdown();
+}
+
+bool FHandTrackingReplaySource::Open()
+{
+	Reader.Reset(IFileManager::Get().CreateFileReader(*Settings.FilePath));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	if (!HandTrackingRecording::ReadHeader(*Reader, RecordingHeader))
+	{
+		Reader.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool FHandTrackingReplaySource::Start()
+{
+	if (Thread != nullptr || !Reader)
+	{
+		return false;
+	}
+
+	bStopRequested = false;
+	Thread = FRunnableThread::Create(this, TEXT("HandTrackingReplay"), 0, TPri_AboveNormal);
+	return Thread != nullptr;
+}
+
+void FHandTrackingReplaySource::Shutdown()
+{
+	if (Thread)
+	{
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+	Reader.Reset();
+}
+
+bool FHandTrackingReplaySource::PopLatestFrame(FHandTrackingRawFrame& OutFrame)
+{
+	return FrameQueue.PopLatest(OutFrame);
+}
+
+FHandTrackingReceiveStats FHandTrackingReplaySource::GetStats() const
+{
+	FHandTrackingReceiveStats Stats;
+	Stats.DroppedFrames = static_cast<int32>(FrameQueue.GetDroppedFrameCount());
+	return Stats;
+}
+
+EHandTrackingConnectionState FHandTrackingReplaySource::GetConnectionState() const
+{
+	return ConnectionState.load(std::memory_order_relaxed);
+}
+
+uint32 FHandTrackingReplaySource::Run()
+{
+	SetConnectionState(EHandTrackingConnectionState::Connected);
+
+	const double FixedInterval = 1.0 / FMath::Max(Settings.FixedRate, 1.0f);
+	// 다음 프레임을 내보낼 시각. 녹화 간격(또는 고정 간격)을 누적해 재생이 밀려도 전체 속도는 유지한다.
+	double NextFrameTime = FPlatformTime::Seconds();
+	bool bReadSinceRewind = false;
+
+	while (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		uint32 ArrivalDeltaUs = 0;
+		if (!ReadNextRecord(ArrivalDeltaUs))
+		{
+			if (!Settings.bLoop || !bReadSinceRewind)
+			{
+				break;
+			}
+			Rewind();
+			NextFrameTime = FPlatformTime::Seconds();
+			bReadSinceRewind = false;
+			continue;
+		}
+		bReadSinceRewind = true;
+
+		bool bKeepRunning = true;
+		switch (Settings.Pacing)
+		{
+		case EHandTrackingReplayPacing::OriginalSpeed:
+			NextFrameTime += static_cast<double>(ArrivalDeltaUs) * 1.0e-6;
+			bKeepRunning = WaitUntil(NextFrameTime);
+			break;
+
+		case EHandTrackingReplayPacing::FixedRate:
+			NextFrameTime += FixedInterval;
+			bKeepRunning = WaitUntil(NextFrameTime);
+			break;
+
+		case EHandTrackingReplayPacing::AsFastAsPossible:
+			// 게임 스레드가 앞 프레임을 가져간 뒤에 넣어야 모든 프레임이 한 번씩 처리된다.
+			while (!FrameQueue.IsDrained() && !bStopRequested.load(std::memory_order_relaxed))
+			{
+				FPlatformProcess::Sleep(0.0f);
+			}
+			bKeepRunning = !bStopRequested.load(std::memory_order_relaxed);
+			break;
+		}
+
+		if (!bKeepRunning)
+		{
+			break;
+		}
+		FrameQueue.Publish(ReplayFrame.GetData(), ReplayFrame.Num());
+	}
+
+	if (!bStopRequested.load(std::memory_order_relaxed))
+	{
+		UE_LOG(LogHandTracking, Log, TEXT("Hand tracking replay of '%s' finished."), *Settings.FilePath);
+	}
+
+	// 마지막 프레임이 링에 들어갈 때까지는 기다렸다가 재생 종료를 알린다.
+	while (!FrameQueue.IsDrained() && !bStopRequested.load(std::memory_order_relaxed))
+	{
+		FrameQueue.FlushPending();
+		FPlatformProcess::Sleep(0.001f);
+	}
+	SetConnectionState(EHandTrackingConnectionState::Disconnected);
+	return 0;
+}
+
+void FHandTrackingReplaySource::Stop()
+{
+	bStopRequested = true;
+}
+
+bool FHandTrackingReplaySource::ReadNextRecord(uint32& OutArrivalDeltaUs)
+{
+	if (Reader->Tell() + HandTrackingRecording::RecordHeaderSize > Reader->TotalSize())
+	{
+		return false;
+	}
+
+	uint32 PayloadSize = 0;
+	*Reader << OutArrivalDeltaUs << PayloadSize;
+	if (Reader->IsError() || Reader->Tell() + PayloadSize > Reader->TotalSize())
+	{
+		// 녹화 도중 종료되어 마지막 레코드가 잘렸다.
+		return false;
+	}
+
+	ReplayFrame.SetNumUninitialized(PayloadSize, false);
+	Reader->Serialize(ReplayFrame.GetData(), PayloadSize);
+	return !Reader->IsError();
+}
+
+void FHandTrackingReplaySource::Rewind()
+{
+	Reader->Seek(HandTrackingRecording::HeaderSize);
+}
+
+bool FHandTrackingReplaySource::WaitUntil(double TargetTime)
+{
+	for (;;)
+	{
+		if (bStopRequested.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		FrameQueue.FlushPending();
+
+		const double Remaining = TargetTime - FPlatformTime::Seconds();
+		if (Remaining <= 0.0)
+		{
+			return true;
+		}
+		FPlatformProcess::Sleep(Remaining > SpinWaitSeconds ? static_cast<float>(FMath::Min(Remaining - SpinWaitSeconds, 0.05)) : 0.0f);
+	}
+}
+
+void FHandTrackingReplaySource::SetConnectionState(EHandTrackingConnectionState NewState)
+{
+	const EHandTrackingConnectionState OldState = ConnectionState.exchange(NewState, std::memory_order_relaxed);
+	if (OldState != NewState && OnConnectionStateChanged)
+	{
+		OnConnectionStateChanged(NewState);
+	}
+}
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingSequenceFilter.h"
+
+FHandTrackingSequenceFilter::EResult FHandTrackingSequenceFilter::Accept(uint32 Sequence)
+{
+	// 시퀀스가 한 바퀴 돌아도 동작하도록 부호 있는 차이로 비교
+	const int32 Delta = static_cast<int32>(Sequence - LatestSequence);
+
+	if (!bHasSequence || Delta <= -RestartThreshold)
+	{
+		bHasSequence = true;
+		LatestSequence = Sequence;
+		ReceivedWindow = 1;
+		++AcceptedCount;
+		return EResult::Accepted;
+	}
+
+	if (Delta > 0)
+	{
+		// 새 프레임. 사이에 빠진 번호는 일단 손실로 센다.
+		LostCount += static_cast<uint32>(Delta - 1);
+		ReceivedWindow = (Delta < WindowSize) ? ((ReceivedWindow << Delta) | 1) : 1;
+		LatestSequence = Sequence;
+		++AcceptedCount;
+		return EResult::Accepted;
+	}
+
+	const int32 Age = -Delta;
+	if (Age < WindowSize)
+	{
+		const uint64 Bit = uint64(1) << Age;
+		if (ReceivedWindow & Bit)
+		{
+			++DuplicateCount;
+			return EResult::Duplicate;
+		}
+
+		// 손실로 셌던 패킷이 늦게 도착했다. 이미 더 새 프레임을 썼으므로 버린다.
+		ReceivedWindow |= Bit;
+		if (LostCount > 0)
+		{
+			--LostCount;
+		}
+	}
+
+	++ReorderedCount;
+	return EResult::Late;
+}
+
+void FHandTrackingSequenceFilter::Reset()
+{
+	*this = FHandTrackingSequenceFilter();
+}
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingSettings.h"
+
+UHandTrackingSettings::UHandTrackingSettings()
+{
+	CategoryName = TEXT("Game");
+	SectionName = TEXT("Hand Tracking");
+}
+
+FMatrix44f UHandTrackingSettings::GetCalibrationMatrix() const
+{
+	const float CenterX = static_cast<float>(TrackerImageSize.X) * 0.5f;
+	const float CenterY = static_cast<float>(TrackerImageSize.Y) * 0.5f;
+	const FVector3f Scale(TrackerScale);
+	const FVector3f Offset(UnrealOffset);
+
+	// UnrealX = z * Sz + Ox
+	// UnrealY = (x - Cx) * Sx + Oy
+	// UnrealZ = (Cy - y) * Sy + Oz
+	return FMatrix44f(
+		FPlane4f(0.0f, Scale.X, 0.0f, 0.0f),
+		FPlane4f(0.0f, 0.0f, -Scale.Y, 0.0f),
+		FPlane4f(Scale.Z, 0.0f, 0.0f, 0.0f),
+		FPlane4f(Offset.X, Offset.Y - CenterX * Scale.X, Offset.Z + CenterY * Scale.Y, 1.0f));
+}
@@ -0,0 +1,204 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingSharedMemorySource.h"
+
+#include "HandTracking/HandTrackingProtocol.h"
+#include "HandTracking/HandTrackingRecorder.h"
+#include "HandTracking/HandTrackingStats.h"
+
+namespace
+{
+	// 헤더 필드 오프셋
+	constexpr int32 MagicOffset = 0;
+	constexpr int32 VersionOffset = 4;
+	constexpr int32 SlotCountOffset = 8;
+	constexpr int32 SlotSizeOffset = 12;
+	constexpr int32 WriteCountOffset = 16;
+
+	// 슬롯 필드 오프셋
+	constexpr int32 SeqLockOffset = 0;
+	constexpr int32 PayloadSizeOffset = 4;
+	constexpr int32 FrameIndexOffset = 8;
+
+	// 쓰는 쪽이 링을 한 바퀴 돌아 읽던 슬롯을 덮어쓴 경우에만 더 새 프레임으로 다시 시도한다.
+	constexpr int32 MaxReadAttempts = 3;
+
+	FORCEINLINE uint32 ReadUInt32(const uint8* Address)
+	{
+		return static_cast<uint32>(FPlatformAtomics::AtomicRead(reinterpret_cast<volatile const int32*>(Address)));
+	}
+
+	FORCEINLINE uint64 ReadUInt64(const uint8* Address)
+	{
+		return static_cast<uint64>(FPlatformAtomics::AtomicRead(reinterpret_cast<volatile const int64*>(Address)));
+	}
+}
+
+FHandTrackingSharedMemorySource::FHandTrackingSharedMemorySource(const FString& InRegionName)
+	: RegionName(InRegionName)
+{
+}
+
+FHandTrackingSharedMemorySource::~FHandTrackingSharedMemorySource()
+{
+	Shutdown();
+}
+
+SIZE_T FHandTrackingSharedMemorySource::GetRegionSize(uint32 InSlotCount, uint32 InSlotSize)
+{
+	return HeaderSize + static_cast<SIZE_T>(InSlotCount) * (SlotHeaderSize + InSlotSize);
+}
+
+bool FHandTrackingSharedMemorySource::Open()
+{
+	if (Region)
+	{
+		return true;
+	}
+
+	const uint32 DefaultSlotSize = HandTrackingProtocol::MaxBinaryFrameSize;
+	const SIZE_T DefaultRegionSize = GetRegionSize(DefaultSlotCount, DefaultSlotSize);
+	const uint32 AccessMode = FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write;
+
+	// 트래커가 먼저 떠 있으면 그 영역에 붙고, 아니면 만들어 두고 트래커가 붙기를 기다린다.
+	bool bCreated = false;
+	Region = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, false, AccessMode, DefaultRegionSize);
+	if (Region == nullptr)
+	{
+		Region = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, true, AccessMode, DefaultRegionSize);
+		bCreated = true;
+	}
+	if (Region == nullptr)
+	{
+		return false;
+	}
+
+	BaseAddress = static_cast<uint8*>(Region->GetAddress());
+	if (bCreated)
+	{
+		FMemory::Memzero(BaseAddress, DefaultRegionSize);
+		FMemory::Memcpy(BaseAddress + MagicOffset, &Magic, sizeof(uint32));
+		FMemory::Memcpy(BaseAddress + VersionOffset, &Version, sizeof(uint32));
+		FMemory::Memcpy(BaseAddress + SlotCountOffset, &DefaultSlotCount, sizeof(uint32));
+		FMemory::Memcpy(BaseAddress + SlotSizeOffset, &DefaultSlotSize, sizeof(uint32));
+	}
+
+	SlotCount = ReadUInt32(BaseAddress + SlotCountOffset);
+	SlotSize = ReadUInt32(BaseAddress + SlotSizeOffset);
+
+	const bool bValidHeader = ReadUInt32(BaseAddress + MagicOffset) == Magic
+		&& ReadUInt32(BaseAddress + VersionOffset) == Version
+		&& SlotCount > 0
+		&& GetRegionSize(SlotCount, SlotSize) <= Region->GetSize();
+	if (!bValidHeader)
+	{
+		UE_LOG(LogHandTracking, Warning, TEXT("Shared memory region '%s' has an unexpected layout."), *RegionName);
+		Shutdown();
+		return false;
+	}
+
+	// 붙기 전에 쓰여 있던 프레임은 새 프레임으로 치지 않는다.
+	LastReadCount = ReadUInt64(BaseAddress + WriteCountOffset);
+	return true;
+}
+
+bool FHandTrackingSharedMemorySource::PopLatestFrame(FHandTrackingRawFrame& OutFrame)
+{
+	if (BaseAddress == nullptr)
+	{
+		return false;
+	}
+
+	for (int32 Attempt = 0; Attempt < MaxReadAttempts; ++Attempt)
+	{
+		const uint64 WriteCount = ReadUInt64(BaseAddress + WriteCountOffset);
+		if (WriteCount == LastReadCount)
+		{
+			return false;
+		}
+		if (WriteCount < LastReadCount)
+		{
+			// 트래커가 다시 시작해 카운터가 초기화됐다.
+			LastReadCount = 0;
+		}
+
+		const uint8* Slot = GetSlot(static_cast<uint32>((WriteCount - 1) % SlotCount));
+		const uint32 SeqBegin = ReadUInt32(Slot + SeqLockOffset);
+		if (SeqBegin & 1)
+		{
+			continue;
+		}
+
+		// 슬롯에 든 프레임이 WriteCount가 가리키는 그 프레임인지 확인한다. 다르면 쓰는 쪽이 링을 한 바퀴 돌아 덮어쓴 것이다.
+		const uint64 ExpectedFrameIndex = WriteCount - 1;
+		const uint32 PayloadSize = ReadUInt32(Slot + PayloadSizeOffset);
+		if (ReadUInt64(Slot + FrameIndexOffset) != ExpectedFrameIndex || PayloadSize > SlotSize)
+		{
+			ConsumeLostFrame(WriteCount);
+			continue;
+		}
+
+		OutFrame.Data.SetNumUninitialized(PayloadSize, false);
+		FMemory::Memcpy(OutFrame.Data.GetData(), Slot + SlotHeaderSize, PayloadSize);
+
+		// 복사가 끝난 뒤에 SeqLock과 FrameIndex를 다시 읽어 그 사이 덮어쓰이지 않았는지 확인
+		FPlatformMisc::MemoryBarrier();
+		if (ReadUInt32(Slot + SeqLockOffset) != SeqBegin || ReadUInt64(Slot + FrameIndexOffset) != ExpectedFrameIndex)
+		{
+			// 찢어진 프레임은 버린다. WriteCount를 다시 읽어 더 새 프레임이 있으면 그것을 읽는다.
+			ConsumeLostFrame(WriteCount);
+			continue;
+		}
+
+		if (LastReadCount > 0)
+		{
+			Stats.DroppedFrames += static_cast<int32>(WriteCount - LastReadCount - 1);
+		}
+		LastReadCount = WriteCount;
+		OutFrame.ArrivalTime = FPlatformTime::Seconds();
+		if (Recorder.IsValid())
+		{
+			Recorder->RecordFrame(OutFrame.Data.GetData(), OutFrame.Data.Num());
+		}
+		return true;
+	}
+
+	return false;
+}
+
+void FHandTrackingSharedMemorySource::ConsumeLostFrame(uint64 WriteCount)
+{
+	// 건너뛴 프레임은 버린 프레임, 읽다가 덮어쓰인 이 프레임은 잃은 프레임으로 센다 (UDP 시퀀스 필터와 같다).
+	if (LastReadCount > 0)
+	{
+		Stats.DroppedFrames += static_cast<int32>(WriteCount - LastReadCount - 1);
+	}
+	++Stats.LostPackets;
+	LastReadCount = WriteCount;
+}
+
+FHandTrackingReceiveStats FHandTrackingSharedMemorySource::GetStats() const
+{
+	return Stats;
+}
+
+EHandTrackingConnectionState FHandTrackingSharedMemorySource::GetConnectionState() const
+{
+	return BaseAddress ? EHandTrackingConnectionState::Connected : EHandTrackingConnectionState::Disconnected;
+}
+
+void FHandTrackingSharedMemorySource::Shutdown()
+{
+	if (Region)
+	{
+		FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+		Region = nullptr;
+		BaseAddress = nullptr;
+	}
+}
+
+uint8* FHandTrackingSharedMemorySource::GetSlot(uint32 SlotIndex) const
+{
+	return BaseAddress + HeaderSize + static_cast<SIZE_T>(SlotIndex) * (SlotHeaderSize + SlotSize);
+}
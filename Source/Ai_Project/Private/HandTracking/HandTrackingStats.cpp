@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingStats.h"
+
+DEFINE_LOG_CATEGORY(LogHandTracking);
+
+DEFINE_STAT(STAT_HandTracking_Receive);
+DEFINE_STAT(STAT_HandTracking_Reassembly);
+DEFINE_STAT(STAT_HandTracking_Parse);
+DEFINE_STAT(STAT_HandTracking_Convert);
+DEFINE_STAT(STAT_HandTracking_Filter);
+DEFINE_STAT(STAT_HandTracking_Solve);
+DEFINE_STAT(STAT_HandTracking_Apply);
+DEFINE_STAT(STAT_HandTracking_Pose);
+
+DEFINE_STAT(STAT_HandTracking_EndToEndP50);
+DEFINE_STAT(STAT_HandTracking_EndToEndP95);
+DEFINE_STAT(STAT_HandTracking_EndToEndP99);
+DEFINE_STAT(STAT_HandTracking_CaptureToReceiveP50);
+DEFINE_STAT(STAT_HandTracking_CaptureToReceiveP95);
+DEFINE_STAT(STAT_HandTracking_CaptureToReceiveP99);
+DEFINE_STAT(STAT_HandTracking_ReceiveToApplyP50);
+DEFINE_STAT(STAT_HandTracking_ReceiveToApplyP95);
+DEFINE_STAT(STAT_HandTracking_ReceiveToApplyP99);
+
+DEFINE_STAT(STAT_HandTracking_JitterBufferDepth);
+DEFINE_STAT(STAT_HandTracking_JitterUnderflows);
+DEFINE_STAT(STAT_HandTracking_JitterOverflows);
+
+DEFINE_STAT(STAT_HandTracking_TransformUpdates);
+DEFINE_STAT(STAT_HandTracking_TransformUpdatesSaved);
+DEFINE_STAT(STAT_HandTracking_RenderDirties);
+DEFINE_STAT(STAT_HandTracking_RenderDirtiesSaved);
+
+DEFINE_STAT(STAT_HandTracking_RequestedRate);
+DEFINE_STAT(STAT_HandTracking_FrameHeadroom);
+
+DEFINE_STAT(STAT_HandTracking_ClockOffset);
+DEFINE_STAT(STAT_HandTracking_ClockDrift);
+DEFINE_STAT(STAT_HandTracking_ClockRoundTrip);
+
+UE_TRACE_CHANNEL_DEFINE(HandTrackingChannel);
@@ -0,0 +1,299 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingStreamBenchmarkCommandlet.h"
+
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/UdpSocketBuilder.h"
+#include "HandTracking/HandTrackingCompactCodec.h"
+#include "HandTracking/HandTrackingPosePipeline.h"
+#include "HandTracking/HandTrackingProtocol.h"
+#include "HandTracking/HandTrackingReceiveWorker.h"
+#include "HandTracking/HandTrackingStats.h"
+#include "HandTracking/HandTrackingSyntheticMotion.h"
+
+namespace
+{
+	// 워커가 I/O 스레드에서 바인딩을 마칠 때까지 기다리는 시간
+	constexpr float WarmUpSeconds = 0.2f;
+
+	template <typename EnumType>
+	void ParseEnumValue(const FString& Params, const TCHAR* Key, EnumType& InOutValue)
+	{
+		FString Name;
+		if (FParse::Value(*Params, Key, Name))
+		{
+			const int64 Value = StaticEnum<EnumType>()->GetValueByNameString(Name);
+			if (Value != INDEX_NONE)
+			{
+				InOutValue = static_cast<EnumType>(Value);
+			}
+			else
+			{
+				UE_LOG(LogHandTracking, Warning, TEXT("Unknown value '%s' for %s"), *Name, Key);
+			}
+		}
+	}
+
+	// 게임 쪽에서 스트림 하나가 가진 상태 (ASocketClient + 구독하는 AAI_Pawn의 포즈 파이프라인)
+	struct FBenchmarkStream
+	{
+		TUniquePtr<FHandTrackingReceiveWorker> Worker;
+		TSharedPtr<FInternetAddr> RemoteAddr;
+		TUniquePtr<FHandTrackingSyntheticMotion> Motion;
+		FHandTrackingCompactEncoder CompactEncoder;
+		FHandTrackingFrame SentFrame;
+		// 디코딩 태스크가 읽으므로 그 태스크가 끝날 때까지 다시 꺼내지 않는다.
+		FHandTrackingRawFrame RawFrame;
+		TUniquePtr<FHandTrackingPosePipeline> Pipeline;
+		double NextSendTime = 0.0;
+		uint32 Sequence = 0;
+	};
+}
+
+UHandTrackingStreamBenchmarkCommandlet::UHandTrackingStreamBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UHandTrackingStreamBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString StreamsList = TEXT("1,4,16");
+	FParse::Value(*Params, TEXT("Streams="), StreamsList);
+	ParseEnumValue(Params, TEXT("Format="), WireFormat);
+	FParse::Value(*Params, TEXT("Port="), BasePort);
+	FParse::Value(*Params, TEXT("Rate="), Rate);
+	FParse::Value(*Params, TEXT("TickRate="), TickRate);
+	FParse::Value(*Params, TEXT("Duration="), DurationSeconds);
+
+	Rate = FMath::Clamp(Rate, 1.0f, 1000.0f);
+	TickRate = FMath::Clamp(TickRate, 1.0f, 1000.0f);
+	DurationSeconds = FMath::Max(DurationSeconds, 1.0f);
+
+	TArray<FString> StreamCountNames;
+	StreamsList.ParseIntoArray(StreamCountNames, TEXT(","));
+
+	TArray<FRunResult> Results;
+	for (const FString& Name : StreamCountNames)
+	{
+		const int32 NumStreams = FCString::Atoi(*Name);
+		if (NumStreams <= 0 || BasePort + NumStreams > 65535)
+		{
+			UE_LOG(LogHandTracking, Warning, TEXT("Skipping invalid stream count '%s'"), *Name);
+			continue;
+		}
+
+		FRunResult& Result = Results.AddDefaulted_GetRef();
+		if (!RunStreams(NumStreams, Result) || IsEngineExitRequested())
+		{
+			break;
+		}
+	}
+
+	UE_LOG(LogHandTracking, Display, TEXT("Streams  Frames/s  Tick mean(us)  p95(us)  max(us)  us/stream  GT mean(us)  Dropped  Lost"));
+	for (const FRunResult& Result : Results)
+	{
+		UE_LOG(LogHandTracking, Display, TEXT("%7d  %8.1f  %13.1f  %7.1f  %7.1f  %9.2f  %11.1f  %7d  %4d"),
+			Result.NumStreams, Result.Seconds > 0.0 ? Result.DecodedFrames / Result.Seconds : 0.0,
+			Result.MeanTickMicros, Result.P95TickMicros, Result.MaxTickMicros, Result.MeanTickMicros / Result.NumStreams,
+			Result.MeanGameThreadMicros, Result.DroppedFrames, Result.LostPackets);
+	}
+	return 0;
+}
+
+bool UHandTrackingStreamBenchmarkCommandlet::RunStreams(int32 NumStreams, FRunResult& OutResult)
+{
+	OutResult.NumStreams = NumStreams;
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FSocket* SendSocket = SocketSubsystem ? FUdpSocketBuilder(TEXT("HandTrackingStreamBenchmarkSend")).WithSendBufferSize(1024 * 1024).Build() : nullptr;
+	if (SendSocket == nullptr)
+	{
+		UE_LOG(LogHandTracking, Error, TEXT("Could not create the sender socket."));
+		return false;
+	}
+
+	const FHandTrackingPosePipelineParams PipelineParams = FHandTrackingPosePipelineParams::FromSettings();
+	const double FrameInterval = 1.0 / Rate;
+	const double TickInterval = 1.0 / TickRate;
+
+	TArray<FBenchmarkStream> Streams;
+	Streams.SetNum(NumStreams);
+	for (int32 StreamIndex = 0; StreamIndex < NumStreams; ++StreamIndex)
+	{
+		FBenchmarkStream& Stream = Streams[StreamIndex];
+
+		FHandTrackingReceiveWorkerSettings WorkerSettings;
+		WorkerSettings.Transport = EHandTrackingTransport::Udp;
+		WorkerSettings.WireFormat = WireFormat;
+		WorkerSettings.Port = BasePort + StreamIndex;
+		// 송신 소켓은 핑에 답하지 않는다.
+		WorkerSettings.ClockSyncInterval = 0.0f;
+		Stream.Worker = MakeUnique<FHandTrackingReceiveWorker>(WorkerSettings, [](EHandTrackingConnectionState) {});
+		if (!Stream.Worker->Start())
+		{
+			UE_LOG(LogHandTracking, Error, TEXT("Could not start the receive worker for port %d."), WorkerSettings.Port);
+			SendSocket->Close();
+			SocketSubsystem->DestroySocket(SendSocket);
+			return false;
+		}
+
+		Stream.RemoteAddr = SocketSubsystem->CreateInternetAddr();
+		Stream.RemoteAddr->SetIp(WorkerSettings.Address.Value);
+		Stream.RemoteAddr->SetPort(WorkerSettings.Port);
+
+		FHandTrackingSyntheticMotionSettings MotionSettings;
+		MotionSettings.Seed = static_cast<uint32>(StreamIndex);
+		Stream.Motion = MakeUnique<FHandTrackingSyntheticMotion>(MotionSettings);
+
+		Stream.Pipeline = MakeUnique<FHandTrackingPosePipeline>(StreamIndex, PipelineParams);
+	}
+
+	FPlatformProcess::Sleep(WarmUpSeconds);
+
+	const double StartTime = FPlatformTime::Seconds();
+	// 실제 트래커들처럼 송신 시점을 스트림마다 조금씩 어긋나게 한다.
+	for (int32 StreamIndex = 0; StreamIndex < NumStreams; ++StreamIndex)
+	{
+		Streams[StreamIndex].NextSendTime = StartTime + FrameInterval * StreamIndex / NumStreams;
+	}
+
+	TArray<double> TickMicros;
+	TickMicros.Reserve(FMath::CeilToInt(DurationSeconds * TickRate) + 1);
+	TArray<FHandTrackingDecodeTask> DecodeTasks;
+	DecodeTasks.Reserve(NumStreams);
+	double TotalGameThreadMicros = 0.0;
+	TArray<uint8> Bytes;
+	double NextTickTime = StartTime;
+
+	while (!IsEngineExitRequested())
+	{
+		double Now = FPlatformTime::Seconds();
+		if (Now - StartTime >= DurationSeconds)
+		{
+			break;
+		}
+		if (Now < NextTickTime)
+		{
+			FPlatformProcess::Sleep(static_cast<float>(NextTickTime - Now));
+			continue;
+		}
+		NextTickTime += TickInterval;
+		if (Now - NextTickTime > 4.0 * TickInterval)
+		{
+			NextTickTime = Now;
+		}
+
+		// 트래커 흉내 (재지 않는다)
+		for (FBenchmarkStream& Stream : Streams)
+		{
+			while (Stream.NextSendTime <= Now)
+			{
+				Stream.NextSendTime += FrameInterval;
+				++Stream.Sequence;
+
+				Stream.Motion->Generate(Now - StartTime, Stream.SentFrame);
+				Stream.SentFrame.CaptureTimestamp = Now;
+				Stream.SentFrame.Sequence = Stream.Sequence;
+
+				Bytes.Reset();
+				HandTrackingProtocol::WriteDatagramHeader(Bytes, Stream.Sequence, static_cast<uint64>(Now * 1.0e6));
+				if (WireFormat == EHandTrackingWireFormat::Compact)
+				{
+					Stream.CompactEncoder.Encode(Stream.SentFrame, Bytes);
+				}
+				else
+				{
+					HandTrackingProtocol::EncodeFrame(WireFormat, Stream.SentFrame, Bytes);
+				}
+
+				int32 BytesSent = 0;
+				SendSocket->SendTo(Bytes.GetData(), Bytes.Num(), BytesSent, *Stream.RemoteAddr);
+			}
+		}
+
+		// 게임 틱 한 번: 스트림마다 AAI_Pawn::Tick(자세 꺼내기, 표시 시각 요청) + UHandTrackingSubsystem::PumpFrames(디코딩 태스크 -> 포즈 파이프라인)
+		const double TickStartTime = FPlatformTime::Seconds();
+		const double DisplayTime = TickStartTime + 2.0 * TickInterval;
+
+		for (FBenchmarkStream& Stream : Streams)
+		{
+			Stream.Pipeline->AcquireLatest();
+			Stream.Pipeline->RequestDisplayTime(DisplayTime);
+		}
+
+		DecodeTasks.Reset();
+		for (FBenchmarkStream& Stream : Streams)
+		{
+			if (!Stream.Worker->PopLatestFrame(Stream.RawFrame))
+			{
+				continue;
+			}
+
+			const FBenchmarkStream* StreamPtr = &Stream;
+			const EHandTrackingWireFormat Format = WireFormat;
+			FHandTrackingDecodeTask DecodeTask = UE::Tasks::Launch(TEXT("HandTrackingDecode"), [StreamPtr, Format]() -> TSharedPtr<const FHandTrackingFrame, ESPMode::ThreadSafe>
+			{
+				TSharedRef<FHandTrackingFrame, ESPMode::ThreadSafe> Frame = MakeShared<FHandTrackingFrame, ESPMode::ThreadSafe>();
+				const TArray<uint8>& Data = StreamPtr->RawFrame.Data;
+				if (!HandTrackingProtocol::DecodeTransportFrame(EHandTrackingTransport::Udp, Format, Data.GetData(), Data.Num(), *Frame))
+				{
+					return nullptr;
+				}
+				Frame->ArrivalTime = StreamPtr->RawFrame.ArrivalTime;
+				return Frame;
+			});
+			Stream.Pipeline->PushFrame(DecodeTask);
+			DecodeTasks.Add(MoveTemp(DecodeTask));
+		}
+		TotalGameThreadMicros += (FPlatformTime::Seconds() - TickStartTime) * 1.0e6;
+
+		// 게임에서는 다음 틱까지 워커에서 돌지만, 스트림당 전체 비용을 재려고 디코딩과 파이프라인이 끝날 때까지 기다린다.
+		UE::Tasks::Wait(DecodeTasks);
+		for (FBenchmarkStream& Stream : Streams)
+		{
+			Stream.Pipeline->Flush();
+		}
+		for (const FHandTrackingDecodeTask& DecodeTask : DecodeTasks)
+		{
+			OutResult.DecodedFrames += DecodeTask.GetResult().IsValid() ? 1 : 0;
+		}
+
+		TickMicros.Add((FPlatformTime::Seconds() - TickStartTime) * 1.0e6);
+	}
+
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+	for (FBenchmarkStream& Stream : Streams)
+	{
+		Stream.Pipeline->Flush();
+		const FHandTrackingReceiveStats Stats = Stream.Worker->GetStats();
+		OutResult.DroppedFrames += Stats.DroppedFrames;
+		OutResult.LostPackets += Stats.LostPackets;
+		Stream.Worker->Shutdown();
+	}
+	SendSocket->Close();
+	SocketSubsystem->DestroySocket(SendSocket);
+
+	OutResult.NumTicks = TickMicros.Num();
+	if (TickMicros.Num() > 0)
+	{
+		double Total = 0.0;
+		for (const double Micros : TickMicros)
+		{
+			Total += Micros;
+		}
+		TickMicros.Sort();
+		OutResult.MeanTickMicros = Total / TickMicros.Num();
+		OutResult.MeanGameThreadMicros = TotalGameThreadMicros / TickMicros.Num();
+		OutResult.P95TickMicros = TickMicros[FMath::Min(TickMicros.Num() * 95 / 100, TickMicros.Num() - 1)];
+		OutResult.MaxTickMicros = TickMicros.Last();
+	}
+
+	UE_LOG(LogHandTracking, Display, TEXT("%d streams: %d ticks, %d frames decoded, tick mean %.1f us, p95 %.1f us, max %.1f us"),
+		NumStreams, OutResult.NumTicks, OutResult.DecodedFrames, OutResult.MeanTickMicros, OutResult.P95TickMicros, OutResult.MaxTickMicros);
+	return true;
+}
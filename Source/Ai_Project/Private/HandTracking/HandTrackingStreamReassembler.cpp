@@ -0,0 +1,242 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingStreamReassembler.h"
+
+#include "HandTracking/HandTrackingProtocol.h"
+
+FHandTrackingStreamReassembler::FHandTrackingStreamReassembler(EHandTrackingWireFormat InWireFormat)
+	: WireFormat(InWireFormat)
+{
+	Buffer.Reserve(64 * 1024);
+}
+
+void FHandTrackingStreamReassembler::Append(const uint8* Data, int32 Size)
+{
+	if (Size <= 0)
+	{
+		return;
+	}
+
+	// 프레임 경계를 끝내 찾지 못하는 스트림이 메모리를 계속 먹지 않도록 한다.
+	if (GetBufferedBytes() + Size > MaxBufferedBytes)
+	{
+		Reset();
+	}
+
+	Buffer.Append(Data, Size);
+}
+
+bool FHandTrackingStreamReassembler::ExtractLatestFrame(TArray<uint8>& OutFrame, int32& OutDroppedCount)
+{
+	int32 LatestStart = INDEX_NONE;
+	int32 LatestEnd = INDEX_NONE;
+	int32 FrameCount = 0;
+
+	// 완성된 프레임은 전부 잘라내되, 복사는 마지막 프레임 한 번만 한다.
+	for (;;)
+	{
+		const int32 FrameEnd = FindFrameEnd();
+		if (FrameEnd == INDEX_NONE)
+		{
+			break;
+		}
+
+		FHandTrackingClockReply ClockReply;
+		if (HandTrackingProtocol::DecodeClockReply(Buffer.GetData() + ReadOffset, FrameEnd - ReadOffset, ClockReply))
+		{
+			ClockReplies.Add(ClockReply);
+			ReadOffset = FrameEnd;
+			ScanOffset = FrameEnd;
+			continue;
+		}
+
+		if (WireFormat == EHandTrackingWireFormat::Compact)
+		{
+			KeyframeCache.Observe(Buffer.GetData() + ReadOffset, FrameEnd - ReadOffset);
+		}
+
+		LatestStart = ReadOffset;
+		LatestEnd = FrameEnd;
+		ReadOffset = FrameEnd;
+		ScanOffset = FrameEnd;
+		++FrameCount;
+	}
+
+	OutDroppedCount = FMath::Max(FrameCount - 1, 0);
+	bool bHasFrame = FrameCount > 0;
+	if (bHasFrame)
+	{
+		OutFrame.Reset();
+		if (WireFormat != EHandTrackingWireFormat::Compact)
+		{
+			OutFrame.Append(Buffer.GetData() + LatestStart, LatestEnd - LatestStart);
+		}
+		else if (!KeyframeCache.Resolve(Buffer.GetData() + LatestStart, LatestEnd - LatestStart, OutFrame))
+		{
+			++OutDroppedCount;
+			bHasFrame = false;
+		}
+	}
+
+	Compact();
+	return bHasFrame;
+}
+
+void FHandTrackingStreamReassembler::Reset()
+{
+	Buffer.Reset();
+	ReadOffset = 0;
+	ScanOffset = 0;
+	BraceDepth = 0;
+	bInString = false;
+	bEscaped = false;
+	KeyframeCache.Reset();
+	ClockReplies.Reset();
+}
+
+int32 FHandTrackingStreamReassembler::FindFrameEnd()
+{
+	switch (WireFormat)
+	{
+	case EHandTrackingWireFormat::Binary:
+		return FindSizedFrameEnd(HandTrackingProtocol::BinaryMagic, HandTrackingProtocol::BinaryHeaderSize, HandTrackingProtocol::MaxBinaryFrameSize);
+	case EHandTrackingWireFormat::Compact:
+		return FindSizedFrameEnd(HandTrackingCompactCodec::Magic, HandTrackingCompactCodec::HeaderSize, HandTrackingCompactCodec::MaxFrameSize);
+	case EHandTrackingWireFormat::Json:
+	default:
+		return FindJsonFrameEnd();
+	}
+}
+
+int32 FHandTrackingStreamReassembler::FindJsonFrameEnd()
+{
+	const int32 BufferSize = Buffer.Num();
+	const uint8* Data = Buffer.GetData();
+
+	// 프레임 사이의 줄바꿈, 공백 등은 건너뛴다. 시계 응답은 '{'로 시작하지 않으므로 여기서 걸러 낸다.
+	if (BraceDepth == 0)
+	{
+		while (ReadOffset < BufferSize && Data[ReadOffset] != '{')
+		{
+			const int32 ClockReplySize = MatchClockReply();
+			if (ClockReplySize == INDEX_NONE)
+			{
+				ScanOffset = ReadOffset;
+				return INDEX_NONE;
+			}
+			if (ClockReplySize > 0)
+			{
+				return ReadOffset + ClockReplySize;
+			}
+			++ReadOffset;
+		}
+		ScanOffset = ReadOffset;
+	}
+
+	for (int32 Index = ScanOffset; Index < BufferSize; ++Index)
+	{
+		const uint8 Char = Data[Index];
+		if (bInString)
+		{
+			if (bEscaped)
+			{
+				bEscaped = false;
+			}
+			else if (Char == '\\')
+			{
+				bEscaped = true;
+			}
+			else if (Char == '"')
+			{
+				bInString = false;
+			}
+		}
+		else if (Char == '"')
+		{
+			bInString = true;
+		}
+		else if (Char == '{')
+		{
+			++BraceDepth;
+		}
+		else if (Char == '}' && --BraceDepth == 0)
+		{
+			return Index + 1;
+		}
+	}
+
+	ScanOffset = BufferSize;
+	return INDEX_NONE;
+}
+
+int32 FHandTrackingStreamReassembler::FindSizedFrameEnd(uint16 Magic, int32 HeaderSize, int32 MaxFrameSize)
+{
+	const uint8* Data = Buffer.GetData();
+
+	while (GetBufferedBytes() >= HeaderSize)
+	{
+		uint32 FrameSize;
+		uint16 FrameMagic;
+		FMemory::Memcpy(&FrameSize, Data + ReadOffset, sizeof(FrameSize));
+		FMemory::Memcpy(&FrameMagic, Data + ReadOffset + 4, sizeof(FrameMagic));
+
+		// 프레임 사이에 끼어 온 시계 응답
+		const int32 ClockReplySize = MatchClockReply();
+		if (ClockReplySize == INDEX_NONE)
+		{
+			break;
+		}
+		if (ClockReplySize > 0)
+		{
+			return ReadOffset + ClockReplySize;
+		}
+
+		// 헤더가 아니면 한 바이트씩 밀면서 다음 프레임 시작을 찾는다.
+		if (FrameMagic != Magic
+			|| FrameSize < static_cast<uint32>(HeaderSize)
+			|| FrameSize > static_cast<uint32>(MaxFrameSize))
+		{
+			++ReadOffset;
+			continue;
+		}
+
+		if (GetBufferedBytes() < static_cast<int32>(FrameSize))
+		{
+			break;
+		}
+		return ReadOffset + static_cast<int32>(FrameSize);
+	}
+
+	return INDEX_NONE;
+}
+
+int32 FHandTrackingStreamReassembler::MatchClockReply() const
+{
+	// FrameSize, Magic, Version이 모두 고정 값이다.
+	static const uint8 ClockHeader[] = { HandTrackingProtocol::ClockFrameSize, 0, 0, 0, 'H', 'K', HandTrackingProtocol::ClockVersion };
+
+	const int32 Available = FMath::Min(GetBufferedBytes(), static_cast<int32>(UE_ARRAY_COUNT(ClockHeader)));
+	if (FMemory::Memcmp(Buffer.GetData() + ReadOffset, ClockHeader, Available) != 0)
+	{
+		return 0;
+	}
+	return (GetBufferedBytes() >= HandTrackingProtocol::ClockFrameSize) ? HandTrackingProtocol::ClockFrameSize : INDEX_NONE;
+}
+
+void FHandTrackingStreamReassembler::Compact()
+{
+	if (ReadOffset >= Buffer.Num())
+	{
+		// 남은 바이트가 없으면 할당은 유지한 채 비운다.
+		Buffer.Reset();
+		ScanOffset = 0;
+		ReadOffset = 0;
+	}
+	else if (ReadOffset > 0 && ReadOffset >= Buffer.Num() / 2)
+	{
+		Buffer.RemoveAt(0, ReadOffset, false);
+		ScanOffset -= ReadOffset;
+		ReadOffset = 0;
+	}
+}
@@ -0,0 +1,218 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingSubsystem.h"
+
+#include "Engine/World.h"
+#include "HandTracking/HandTrackingStats.h"
+#include "RenderCore.h"
+
+void UHandTrackingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// 액터 틱이 끝나자마자 꺼내 이 프레임이 렌더링되는 동안 워커에서 디코딩과 포즈 풀이를 끝내 둔다.
+	// 게임 스레드 구독자에게는 다음 액터 틱 전에 알린다.
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UHandTrackingSubsystem::PumpFrames);
+	PreActorTickHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &UHandTrackingSubsystem::HandlePreActorTick);
+}
+
+void UHandTrackingSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	FWorldDelegates::OnWorldPreActorTick.Remove(PreActorTickHandle);
+	PostActorTickHandle.Reset();
+	PreActorTickHandle.Reset();
+	WaitForDecodes();
+	PendingClients.Reset();
+	DecodeTasks.Reset();
+	PosePipelines.Reset();
+	Clients.Reset();
+	LatestFrame.Reset();
+	FrameReceived.Clear();
+
+	Super::Deinitialize();
+}
+
+bool UHandTrackingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UHandTrackingSubsystem* UHandTrackingSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UHandTrackingSubsystem>() : nullptr;
+}
+
+void UHandTrackingSubsystem::RegisterClient(ASocketClient* Client)
+{
+	if (Client == nullptr || Clients.Contains(Client))
+	{
+		return;
+	}
+	Clients.Add(Client);
+	Client->OnConnectionStateChanged.AddDynamic(this, &UHandTrackingSubsystem::HandleClientConnectionStateChanged);
+	UpdateConnectionState();
+}
+
+void UHandTrackingSubsystem::UnregisterClient(ASocketClient* Client)
+{
+	if (Clients.Remove(Client) > 0)
+	{
+		// 이 연결의 꺼낸 프레임을 읽고 있는 디코딩 태스크가 끝나야 연결을 놓아줄 수 있다.
+		WaitForDecodes();
+		for (int32 Index = PendingClients.Num() - 1; Index >= 0; --Index)
+		{
+			if (PendingClients[Index] == Client)
+			{
+				PendingClients.RemoveAt(Index, 1, false);
+				DecodeTasks.RemoveAt(Index, 1, false);
+			}
+		}
+
+		Client->OnConnectionStateChanged.RemoveDynamic(this, &UHandTrackingSubsystem::HandleClientConnectionStateChanged);
+		UpdateConnectionState();
+	}
+}
+
+void UHandTrackingSubsystem::RegisterPosePipeline(const TSharedRef<FHandTrackingPosePipeline, ESPMode::ThreadSafe>& Pipeline, FSimpleDelegate OnFrameQueued)
+{
+	UnregisterPosePipeline(Pipeline);
+	PosePipelines.Add({ Pipeline, MoveTemp(OnFrameQueued) });
+}
+
+void UHandTrackingSubsystem::UnregisterPosePipeline(const TSharedRef<FHandTrackingPosePipeline, ESPMode::ThreadSafe>& Pipeline)
+{
+	PosePipelines.RemoveAll([&Pipeline](const FPosePipelineEntry& Entry)
+	{
+		return Entry.Pipeline == Pipeline;
+	});
+}
+
+void UHandTrackingSubsystem::PumpFrames(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World != GetWorld() || Clients.Num() == 0)
+	{
+		return;
+	}
+
+	// 액터 틱 전 알림이 없었던 프레임이면 지난 결과를 여기서 마저 알린다. 다시 꺼내면 디코딩 중인 버퍼를 덮어쓴다.
+	DispatchDecodedFrames();
+
+	// 지난 프레임에서 게임/렌더 스레드 중 오래 걸린 쪽으로 트래커 주기를 조절한다. 새 프레임이 없는 틱에도 여유는 잰다.
+	const float FrameSeconds = static_cast<float>(FPlatformTime::ToSeconds(FMath::Max(GGameThreadTime, GRenderThreadTime)));
+	const double Now = FPlatformTime::Seconds();
+	for (ASocketClient* Client : Clients)
+	{
+		if (Client != nullptr)
+		{
+			Client->UpdateRateControl(Now, FrameSeconds);
+#if STATS
+			SET_FLOAT_STAT(STAT_HandTracking_RequestedRate, Client->GetRateController().GetRequestedRate());
+			SET_FLOAT_STAT(STAT_HandTracking_FrameHeadroom, Client->GetRateController().GetHeadroom());
+
+			const FHandTrackingClockEstimate& ClockEstimate = Client->GetClockEstimate();
+			SET_FLOAT_STAT(STAT_HandTracking_ClockOffset, ClockEstimate.Offset * 1000.0);
+			SET_FLOAT_STAT(STAT_HandTracking_ClockDrift, ClockEstimate.Drift * 1.0e6);
+			SET_FLOAT_STAT(STAT_HandTracking_ClockRoundTrip, ClockEstimate.RoundTrip * 1000.0);
+#endif
+		}
+	}
+
+	// 새 프레임이 있는 연결만 골라 낸다. 꺼내기는 링의 소비자인 게임 스레드에서
+	for (ASocketClient* Client : Clients)
+	{
+		if (Client == nullptr || !Client->bIsConnected || !Client->PopPendingFrame())
+		{
+			continue;
+		}
+
+		// 디코딩은 연결마다 따로라 태스크 하나씩. 같은 스트림의 포즈 파이프라인은 그 태스크가 끝나는 대로 이어 돈다.
+		FHandTrackingDecodeTask DecodeTask = UE::Tasks::Launch(TEXT("HandTrackingDecode"), [Client]() -> TSharedPtr<const FHandTrackingFrame, ESPMode::ThreadSafe>
+		{
+			TSharedRef<FHandTrackingFrame, ESPMode::ThreadSafe> Frame = MakeShared<FHandTrackingFrame, ESPMode::ThreadSafe>();
+			if (Client->DecodePendingFrame(*Frame))
+			{
+				return Frame;
+			}
+			return nullptr;
+		});
+		for (FPosePipelineEntry& Entry : PosePipelines)
+		{
+			if (Entry.Pipeline->GetStreamId() == Client->StreamId)
+			{
+				Entry.OnFrameQueued.ExecuteIfBound();
+				Entry.Pipeline->PushFrame(DecodeTask);
+			}
+		}
+
+		PendingClients.Add(Client);
+		DecodeTasks.Add(MoveTemp(DecodeTask));
+	}
+}
+
+void UHandTrackingSubsystem::HandlePreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		DispatchDecodedFrames();
+	}
+}
+
+void UHandTrackingSubsystem::DispatchDecodedFrames()
+{
+	// 지난 프레임이 렌더링되는 동안 끝났을 것이라 대개 기다리지 않는다.
+	// 구독자에게는 게임 스레드에서 스트림 순서대로 알린다.
+	for (int32 Index = 0; Index < DecodeTasks.Num(); ++Index)
+	{
+		const TSharedPtr<const FHandTrackingFrame, ESPMode::ThreadSafe>& Frame = DecodeTasks[Index].GetResult();
+		if (Frame.IsValid())
+		{
+			PendingClients[Index]->ObserveDecodedFrame(*Frame);
+			LatestFrame = Frame;
+			++FrameCount;
+			FrameReceived.Broadcast(Frame.ToSharedRef());
+		}
+	}
+	PendingClients.Reset();
+	DecodeTasks.Reset();
+}
+
+void UHandTrackingSubsystem::WaitForDecodes()
+{
+	UE::Tasks::Wait(DecodeTasks);
+}
+
+void UHandTrackingSubsystem::HandleClientConnectionStateChanged(EHandTrackingConnectionState NewState)
+{
+	UpdateConnectionState();
+}
+
+void UHandTrackingSubsystem::UpdateConnectionState()
+{
+	EHandTrackingConnectionState NewState = EHandTrackingConnectionState::Disconnected;
+	for (const ASocketClient* Client : Clients)
+	{
+		if (Client == nullptr)
+		{
+			continue;
+		}
+		if (Client->ConnectionState == EHandTrackingConnectionState::Connected)
+		{
+			NewState = EHandTrackingConnectionState::Connected;
+			break;
+		}
+		if (Client->ConnectionState == EHandTrackingConnectionState::Connecting)
+		{
+			NewState = EHandTrackingConnectionState::Connecting;
+		}
+	}
+
+	if (NewState != ConnectionState)
+	{
+		ConnectionState = NewState;
+		UE_LOG(LogHandTracking, Log, TEXT("Hand tracker connection state: %s"), *UEnum::GetValueAsString(NewState));
+		OnConnectionStateChanged.Broadcast(NewState);
+	}
+}
@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HandTracking/HandTrackingSyntheticMotion.h"
+
+namespace
+{
+	// 손바닥 길이를 1로 둔 손 모양. 손가락은 로컬 +Y 방향으로 뻗고, 굽히면 -Z(카메라 쪽)로 말린다.
+	struct FSyntheticFinger
+	{
+		// 첫 랜드마크 ID (엄지 1, 검지 5, 중지 9, 약지 13, 새끼 17)
+		int32 FirstLandmark;
+		float BaseX;
+		float BaseY;
+		// 손가락이 벌어진 각도 (라디안, +면 엄지 쪽)
+		float Spread;
+		float SegmentLengths[3];
+		float CurlPhase;
+	};
+
+	constexpr FSyntheticFinger Fingers[] =
+	{
+		// 엄지는 CMC(1)가 기준점이고 나머지 세 마디가 MCP, IP, 끝
+		{ 1, 0.25f, 0.20f, 0.70f, { 0.35f, 0.30f, 0.25f }, 0.0f },
+		{ 5, 0.30f, 0.90f, 0.10f, { 0.40f, 0.25f, 0.20f }, 0.6f },
+		{ 9, 0.05f, 0.95f, 0.00f, { 0.45f, 0.28f, 0.22f }, 1.2f },
+		{ 13, -0.18f, 0.88f, -0.08f, { 0.40f, 0.26f, 0.20f }, 1.8f },
+		{ 17, -0.38f, 0.75f, -0.18f, { 0.32f, 0.20f, 0.18f }, 2.4f },
+	};
+
+	// 손가락 한 마디가 완전히 굽었을 때의 각도
+	constexpr float MaxJointCurl = 1.2f;
+	// 화면 대비 손바닥 길이
+	constexpr float HandScale = 0.12f;
+	constexpr float WristCircleRadius = 0.08f;
+	constexpr float WristCircleHz = 0.25f;
+	constexpr float CurlHz = 0.5f;
+}
+
+FHandTrackingSyntheticMotion::FHandTrackingSyntheticMotion(const FHandTrackingSyntheticMotionSettings& InSettings)
+	: Settings(InSettings)
+	, RandomStream(static_cast<int32>(InSettings.Seed))
+{
+}
+
+void FHandTrackingSyntheticMotion::Generate(double TimeSeconds, FHandTrackingFrame& OutFrame)
+{
+	OutFrame.NumHands = FMath::Clamp(Settings.NumHands, 0, MaxTrackedHands);
+
+	// 한 손만 보낼 때는 오른손
+	for (int32 HandIndex = 0; HandIndex < OutFrame.NumHands; ++HandIndex)
+	{
+		const EHandedness Handedness = (HandIndex == 0) ? EHandedness::Right : EHandedness::Left;
+		GenerateHand(TimeSeconds, Handedness, OutFrame.Hands[HandIndex]);
+	}
+}
+
+void FHandTrackingSyntheticMotion::GenerateHand(double TimeSeconds, EHandedness Handedness, FHandFrame& OutHand)
+{
+	const bool bLeft = (Handedness == EHandedness::Left);
+	const float Time = static_cast<float>(TimeSeconds);
+	const float HandPhase = bLeft ? PI : 0.0f;
+
+	// 손목은 화면의 왼쪽/오른쪽 절반에서 원을 그리고, 손 전체가 조금씩 기울어진다.
+	const float CircleAngle = 2.0f * PI * WristCircleHz * Time + HandPhase;
+	const FVector2f Wrist(
+		(bLeft ? 0.35f : 0.65f) + WristCircleRadius * FMath::Cos(CircleAngle),
+		0.60f + WristCircleRadius * FMath::Sin(CircleAngle));
+	const float Roll = 0.3f * FMath::Sin(2.0f * PI * 0.2f * Time + HandPhase);
+	const float CosRoll = FMath::Cos(Roll);
+	const float SinRoll = FMath::Sin(Roll);
+	const float Mirror = bLeft ? -1.0f : 1.0f;
+
+	// 로컬 손 좌표 -> 정규화 이미지 좌표 (이미지 y는 아래로 증가)
+	auto ToImage = [&](const FVector3f& Local)
+	{
+		const float X = Local.X * Mirror;
+		const float RotatedX = X * CosRoll - Local.Y * SinRoll;
+		const float RotatedY = X * SinRoll + Local.Y * CosRoll;
+		return FVector3f(Wrist.X + RotatedX * HandScale, Wrist.Y - RotatedY * HandScale, Local.Z * HandScale);
+	};
+	auto SetJoint = [&](int32 LandmarkId, const FVector3f& Local)
+	{
+		const FVector3f Image = ToImage(Local);
+		OutHand.SetLandmark(LandmarkId, Image.X, Image.Y, Image.Z);
+	};
+
+	OutHand.Handedness = Handedness;
+	SetJoint(0, FVector3f::ZeroVector);
+
+	for (const FSyntheticFinger& Finger : Fingers)
+	{
+		const float Curl = 0.5f + 0.5f * FMath::Sin(2.0f * PI * CurlHz * Time + Finger.CurlPhase + HandPhase);
+		const float SinSpread = FMath::Sin(Finger.Spread);
+		const float CosSpread = FMath::Cos(Finger.Spread);
+
+		FVector3f Joint(Finger.BaseX, Finger.BaseY, 0.0f);
+		SetJoint(Finger.FirstLandmark, Joint);
+
+		float JointAngle = 0.0f;
+		for (int32 Segment = 0; Segment < 3; ++Segment)
+		{
+			JointAngle += Curl * MaxJointCurl;
+			const float Length = Finger.SegmentLengths[Segment];
+			const float Forward = Length * FMath::Cos(JointAngle);
+			Joint += FVector3f(SinSpread * Forward, CosSpread * Forward, -Length * FMath::Sin(JointAngle));
+			SetJoint(Finger.FirstLandmark + Segment + 1, Joint);
+		}
+	}
+
+	if (Settings.LandmarkJitter > 0.0f)
+	{
+		for (int32 Id = 0; Id < HandLandmarkCount; ++Id)
+		{
+			OutHand.X[Id] += NextGaussian() * Settings.LandmarkJitter;
+			OutHand.Y[Id] += NextGaussian() * Settings.LandmarkJitter;
+			OutHand.Z[Id] += NextGaussian() * Settings.LandmarkJitter;
+		}
+	}
+}
+
+float FHandTrackingSyntheticMotion::NextGaussian()
+{
+	// Box-Muller
+	const float U1 = FMath::Max(RandomStream.GetFraction(), UE_SMALL_NUMBER);
+	const float U2 = RandomStream.GetFraction();
+	return FMath::Sqrt(-2.0f * FMath::Loge(U1)) * FMath::Cos(2.0f * PI * U2);
+}
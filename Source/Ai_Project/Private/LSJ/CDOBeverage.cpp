@@ -3,27 +3,60 @@
 
 #include "LSJ/CDOBeverage.h"
 
-#include "LSJ/BeverageUnit.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
 
 
 // Sets default values
 ACDOBeverage::ACDOBeverage()
 {
-	
+
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = false;
+	// 방울이 있을 때만 켠다.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
 
-	
+	// 인스턴스 트랜스폼을 월드 좌표 그대로 쓰도록 액터가 움직여도 따라가지 않게 둔다.
+	for (int32 i = 0; EBeverage::BeerMax > i; i++)
+	{
+		UInstancedStaticMeshComponent* _BeverageMesh = CreateDefaultSubobject<UInstancedStaticMeshComponent>(*FString::Printf(TEXT("DropletMesh%d"), i));
+		_BeverageMesh->SetupAttachment(RootComponent);
+		_BeverageMesh->SetUsingAbsoluteLocation(true);
+		_BeverageMesh->SetUsingAbsoluteRotation(true);
+		_BeverageMesh->SetUsingAbsoluteScale(true);
+		_BeverageMesh->SetMobility(EComponentMobility::Movable);
+		_BeverageMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		_BeverageMesh->SetCastShadow(false);
+		BeverageMeshes.Push(_BeverageMesh);
+	}
 }
 
 // Called when the game starts or when spawned
 void ACDOBeverage::BeginPlay()
 {
 	Super::BeginPlay();
-	for (int32 i = 0; CDOSize > i; i++)
+
+	// 방울 하나는 액터가 아니라 배열마다 한 칸이다.
+	Positions.Reserve(CDOSize);
+	Velocities.Reserve(CDOSize);
+	Lifetimes.Reserve(CDOSize);
+	Beverages.Reserve(CDOSize);
+
+	for (int32 i = 0; BeverageMeshes.Num() > i; i++)
 	{
-		//FActorSpawnParameters _CurrentActorParams;
-		CDOBeverage.Push(GetWorld()->SpawnActor<ABeverageUnit>());
+		BeverageMeshes[i]->SetWorldTransform(FTransform::Identity);
+		if (DropletMesh)
+		{
+			BeverageMeshes[i]->SetStaticMesh(DropletMesh);
+		}
+		if (BeverageMaterials.IsValidIndex(i) && BeverageMaterials[i])
+		{
+			BeverageMeshes[i]->SetMaterial(0, BeverageMaterials[i]);
+		}
 	}
 }
 
@@ -31,13 +64,128 @@ void ACDOBeverage::BeginPlay()
 void ACDOBeverage::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	UpdateDroplets(DeltaTime);
+	UpdateInstances();
+
+	if (Positions.Num() == 0)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+int32 ACDOBeverage::SpawnDroplets(TEnumAsByte<EBeverage> Beverage, const FVector& Location, const FVector& Velocity, int32 Count, float SpreadDegrees)
+{
+	if (Beverage.GetValue() >= EBeverage::BeerMax)
+	{
+		return 0;
+	}
+
+	const int32 _NumSpawn = FMath::Min(Count, CDOSize - Positions.Num());
+	if (_NumSpawn <= 0)
+	{
+		return 0;
+	}
+
+	const float _Speed = Velocity.Size();
+	const FVector _Direction = Velocity.GetSafeNormal();
+	const float _SpreadRadians = FMath::DegreesToRadians(SpreadDegrees);
+	for (int32 i = 0; _NumSpawn > i; i++)
+	{
+		const FVector _DropletVelocity = (_SpreadRadians > 0.0f && _Speed > 0.0f)
+			? FMath::VRandCone(_Direction, _SpreadRadians) * _Speed
+			: Velocity;
+		Positions.Add(FVector3f(Location));
+		Velocities.Add(FVector3f(_DropletVelocity));
+		Lifetimes.Add(DropletLifetime);
+		Beverages.Add(Beverage.GetValue());
+	}
+
+	SetActorTickEnabled(true);
+	return _NumSpawn;
+}
+
+void ACDOBeverage::ClearDroplets()
+{
+	Positions.Reset();
+	Velocities.Reset();
+	Lifetimes.Reset();
+	Beverages.Reset();
+	UpdateInstances();
+}
+
+void ACDOBeverage::UpdateDroplets(float DeltaTime)
+{
+	const float _GravityZ = GetWorld() ? GetWorld()->GetGravityZ() : -980.0f;
+	const FVector3f _Gravity(0.0f, 0.0f, _GravityZ);
+	const float _Damping = FMath::Max(1.0f - DropletDrag * DeltaTime, 0.0f);
+
+	// 배열마다 따로 한 줄로 훑으므로 컴파일러가 벡터화하기 좋다.
+	const int32 _NumDroplets = Positions.Num();
+	FVector3f* _Positions = Positions.GetData();
+	FVector3f* _Velocities = Velocities.GetData();
+	float* _Lifetimes = Lifetimes.GetData();
+	for (int32 i = 0; _NumDroplets > i; i++)
+	{
+		_Velocities[i] = (_Velocities[i] + _Gravity * DeltaTime) * _Damping;
+		_Positions[i] += _Velocities[i] * DeltaTime;
+		_Lifetimes[i] -= DeltaTime;
+	}
+
+	// 수명이 다한 방울은 맨 뒤 방울로 메운다. 순서는 그리기에 상관없다.
+	for (int32 i = Lifetimes.Num() - 1; i >= 0; i--)
+	{
+		if (Lifetimes[i] <= 0.0f)
+		{
+			Positions.RemoveAtSwap(i, 1, false);
+			Velocities.RemoveAtSwap(i, 1, false);
+			Lifetimes.RemoveAtSwap(i, 1, false);
+			Beverages.RemoveAtSwap(i, 1, false);
+		}
+	}
 }
 
-void ACDOBeverage::NextPoolingBeverage()
+void ACDOBeverage::UpdateInstances()
 {
-	CurrentPoolingBeverage++;
-	if (CurrentPoolingBeverage > CDOSize)
+	const FVector _Scale(DropletScale);
+	for (TArray<FTransform>& _Transforms : InstanceTransforms)
+	{
+		_Transforms.Reset();
+	}
+	for (int32 i = 0; Positions.Num() > i; i++)
 	{
-		CurrentPoolingBeverage = 0;
+		InstanceTransforms[Beverages[i]].Emplace(FQuat::Identity, FVector(Positions[i]), _Scale);
+	}
+
+	for (int32 i = 0; BeverageMeshes.Num() > i; i++)
+	{
+		UInstancedStaticMeshComponent* _BeverageMesh = BeverageMeshes[i];
+		const TArray<FTransform>& _Transforms = InstanceTransforms[i];
+		const int32 _NumInstances = _BeverageMesh->GetInstanceCount();
+		if (_Transforms.Num() == 0 && _NumInstances == 0)
+		{
+			continue;
+		}
+
+		// 인스턴스 수는 방울 수에 맞추고, 남는 인스턴스는 뒤에서부터 지운다.
+		if (_NumInstances > _Transforms.Num())
+		{
+			TArray<int32> _RemovedInstances;
+			_RemovedInstances.Reserve(_NumInstances - _Transforms.Num());
+			for (int32 j = _NumInstances - 1; j >= _Transforms.Num(); j--)
+			{
+				_RemovedInstances.Add(j);
+			}
+			_BeverageMesh->RemoveInstances(_RemovedInstances);
+		}
+		const int32 _NumExisting = FMath::Min(_NumInstances, _Transforms.Num());
+		if (_NumExisting > 0)
+		{
+			_BeverageMesh->BatchUpdateInstancesTransforms(0, TArrayView<const FTransform>(_Transforms.GetData(), _NumExisting), true, true, true);
+		}
+		if (_Transforms.Num() > _NumExisting)
+		{
+			_BeverageMesh->AddInstances(TArray<FTransform>(_Transforms.GetData() + _NumExisting, _Transforms.Num() - _NumExisting), false, true);
+		}
 	}
 }
@@ -3,11 +3,16 @@
 
 #include "LSJ/DispenserActor.h"
 
+#include "Kismet/GameplayStatics.h"
+#include "LSJ/CDOBeverage.h"
+
 // Sets default values
 ADispenserActor::ADispenserActor()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = false;
+	// 따르는 동안만 켠다.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	FluxHandleComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("FluxHandle"));
 	DispenserComp = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Dispenser"));
@@ -20,6 +25,11 @@ void ADispenserActor::BeginPlay()
 {
 	Super::BeginPlay();
 
+	SetEBeverage(Beverage, BeerBeverage);
+	if (!ArrayCDOBeverage)
+	{
+		ArrayCDOBeverage = Cast<ACDOBeverage>(UGameplayStatics::GetActorOfClass(this, ACDOBeverage::StaticClass()));
+	}
 }
 
 // Called every frame
@@ -27,5 +37,28 @@ void ADispenserActor::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	PendingDroplets += PourRate * DeltaTime;
+	DropBeverage(Beverage, ArrayCDOBeverage);
+}
+
+void ADispenserActor::SetPouring(bool bInPouring)
+{
+	bPouring = bInPouring;
+	PendingDroplets = 0.0f;
+	SetActorTickEnabled(bPouring);
+}
+
+void ADispenserActor::DropBeverage(FBeverage BeverageStruct, ACDOBeverage* InCDOBeverage)
+{
+	const int32 _NumDroplets = FMath::FloorToInt32(PendingDroplets);
+	if (!InCDOBeverage || _NumDroplets <= 0)
+	{
+		return;
+	}
+	PendingDroplets -= _NumDroplets;
+
+	// 손잡이 아래로 떨어뜨린다. 점도가 높을수록 천천히 나온다.
+	const FVector _Velocity = FVector::DownVector * PourSpeed / FMath::Max(BeverageStruct.Viscosity, 0.1f);
+	InCDOBeverage->SpawnDroplets(BeerBeverage, FluxHandleComp->GetComponentLocation(), _Velocity, _NumDroplets, PourSpreadDegrees);
 }
 
@@ -5,6 +5,16 @@
 #include "SocketSubsystem.h"
 #include "Networking.h" 
 #include "Sockets.h"
+#include "Async/Async.h"
+#include "HandTracking/HandTrackingProtocol.h"
+#include "HandTracking/HandTrackingReceiveWorker.h"
+#include "HandTracking/HandTrackingRecorder.h"
+#include "HandTracking/HandTrackingReplaySource.h"
+#include "HandTracking/HandTrackingSettings.h"
+#include "HandTracking/HandTrackingSharedMemorySource.h"
+#include "HandTracking/HandTrackingStats.h"
+#include "HandTracking/HandTrackingSubsystem.h"
+#include "Misc/CommandLine.h"
 
 
 // Sets default values
@@ -19,7 +29,28 @@ ASocketClient::ASocketClient()
 void ASocketClient::BeginPlay()
 {
 	Super::BeginPlay();
+	ApplyCommandLineOverrides();
+
+	bRateControlEnabled = GetDefault<UHandTrackingSettings>()->bEnableRateControl;
+	RateController.SetParams(FHandTrackingRateControlParams::FromSettings());
+
 	ConnectToServer();
+
+	// 프레임은 서브시스템이 한 번 꺼내서 구독자들에게 나눠 준다.
+	if (UHandTrackingSubsystem* HandTracking = UHandTrackingSubsystem::Get(this))
+	{
+		HandTracking->RegisterClient(this);
+	}
+}
+
+void ASocketClient::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UHandTrackingSubsystem* HandTracking = UHandTrackingSubsystem::Get(this))
+	{
+		HandTracking->UnregisterClient(this);
+	}
+	DisconnectFromServer();
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -28,111 +59,347 @@ void ASocketClient::Tick(float DeltaTime)
 	Super::Tick(DeltaTime);
 }
 
-void ASocketClient::ConnectToServer()
+void ASocketClient::ApplyCommandLineOverrides()
 {
-    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
-    if (SocketSubsystem)
+    const TCHAR* CommandLine = FCommandLine::Get();
+
+    FParse::Value(CommandLine, TEXT("HandTrackingRecord="), RecordFilePath);
+    if (FParse::Value(CommandLine, TEXT("HandTrackingReplay="), ReplayFilePath))
+    {
+        Transport = EHandTrackingTransport::Replay;
+    }
+
+    FString PacingName;
+    if (FParse::Value(CommandLine, TEXT("HandTrackingReplayPacing="), PacingName))
     {
-        if (Socket == nullptr) //    ʾҴٸ մϴ.
+        const int64 PacingValue = StaticEnum<EHandTrackingReplayPacing>()->GetValueByNameString(PacingName);
+        if (PacingValue != INDEX_NONE)
         {
-            Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("default"), false);
-            if (Socket == nullptr) {
-                //UE_LOG(LogTemp, Error, TEXT("Failed to create socket."));
-                return;
-            }
+            ReplayPacing = static_cast<EHandTrackingReplayPacing>(PacingValue);
         }
+        else
+        {
+            UE_LOG(LogHandTracking, Warning, TEXT("Unknown replay pacing '%s'."), *PacingName);
+        }
+    }
 
-        //   Ǿ Ȯմϴ.
-        if (Socket != nullptr)
+    FParse::Value(CommandLine, TEXT("HandTrackingReplayRate="), ReplayFixedRate);
+    if (FParse::Param(CommandLine, TEXT("HandTrackingReplayLoop")))
+    {
+        bLoopReplay = true;
+    }
+    if (FParse::Param(CommandLine, TEXT("HandTrackingReplayExit")))
+    {
+        bExitWhenReplayFinished = true;
+    }
+}
+
+void ASocketClient::ConnectToServer()
+{
+    if (FrameSource)
+    {
+        return;
+    }
+
+    FrameTransport = Transport;
+    FrameWireFormat = WireFormat;
+
+    // 녹화 파일은 재생 파일 형식 그대로 만들어 두면 나중에 Replay로 다시 흘려 넣을 수 있습니다.
+    Recorder.Reset();
+    if (!RecordFilePath.IsEmpty() && Transport != EHandTrackingTransport::Replay)
+    {
+        // 공유 메모리는 항상 바이너리 프레임입니다.
+        const EHandTrackingWireFormat RecordWireFormat = (Transport == EHandTrackingTransport::SharedMemory) ? EHandTrackingWireFormat::Binary : WireFormat;
+        Recorder = FHandTrackingRecorder::Create(RecordFilePath, Transport, RecordWireFormat);
+        if (Recorder.IsValid())
         {
-            // IP ּҿ Ʈ Ͽ   õ
-            bool bIsValidIP = FIPv4Address::Parse(Address, IP);
-            if (bIsValidIP)
-            {
-                TSharedRef<FInternetAddr> Addr = SocketSubsystem->CreateInternetAddr();
-                Addr->SetIp(IP.Value);
-                Addr->SetPort(Port);
-                bool bConnected = Socket->Connect(*Addr);
-                //   ο  ļ ó
-                if (bConnected)
-                {
-                    // ῡ ߽ϴ.
-                    UE_LOG(LogTemp, Log, TEXT("Connected to server!"));
-                }
-                else
-                {
-                    // ῡ ߽ϴ.
-                    UE_LOG(LogTemp, Warning, TEXT("Failed to connect to server."));
-                }
-            }
-            else
-            {
-                // IP ּҰ ȿ ʽϴ.
-                UE_LOG(LogTemp, Warning, TEXT("Invalid IP Address."));
-            }
+            UE_LOG(LogHandTracking, Log, TEXT("Recording hand tracking frames to '%s'."), *RecordFilePath);
         }
         else
         {
-            //   ߽ϴ.
-            UE_LOG(LogTemp, Warning, TEXT("Could not create socket."));
+            UE_LOG(LogHandTracking, Warning, TEXT("Could not create hand tracking recording '%s'."), *RecordFilePath);
         }
     }
-    else
+
+    if (Transport == EHandTrackingTransport::Replay)
+    {
+        StartReplay();
+        return;
+    }
+
+    // 같은 PC의 트래커는 공유 메모리에서 바로 읽습니다.
+    if (Transport == EHandTrackingTransport::SharedMemory)
+    {
+        OpenSharedMemory();
+        return;
+    }
+
+    // IP 주소를 확인합니다.
+    bool bIsValidIP = FIPv4Address::Parse(Address, IP);
+    if (!bIsValidIP)
+    {
+        // IP 주소가 유효하지 않습니다.
+        UE_LOG(LogHandTracking, Warning, TEXT("Invalid IP Address."));
+        return;
+    }
+
+    // 접속, 끊김 감지, 재접속은 모두 수신 스레드에서 처리하므로 여기서는 기다리지 않습니다.
+    StartReceiveWorker();
+}
+
+void ASocketClient::OpenSharedMemory()
+{
+    if (WireFormat != EHandTrackingWireFormat::Binary)
+    {
+        // 슬롯 크기가 고정이라 바이너리 프레임만 담을 수 있습니다.
+        UE_LOG(LogHandTracking, Warning, TEXT("Shared memory transport only carries binary frames; switching wire format to Binary."));
+        WireFormat = EHandTrackingWireFormat::Binary;
+        FrameWireFormat = WireFormat;
+    }
+
+    TUniquePtr<FHandTrackingSharedMemorySource> SharedMemorySource = MakeUnique<FHandTrackingSharedMemorySource>(SharedMemoryName);
+    if (!SharedMemorySource->Open())
+    {
+        UE_LOG(LogHandTracking, Warning, TEXT("Could not map shared memory region '%s'."), *SharedMemoryName);
+        return;
+    }
+
+    UE_LOG(LogHandTracking, Log, TEXT("Reading hand tracking frames from shared memory '%s'."), *SharedMemoryName);
+    SharedMemorySource->SetRecorder(Recorder);
+    FrameSource = MoveTemp(SharedMemorySource);
+    HandleConnectionStateChanged(EHandTrackingConnectionState::Connected);
+}
+
+void ASocketClient::StartReceiveWorker()
+{
+    FHandTrackingReceiveWorkerSettings Settings;
+    Settings.Transport = Transport;
+    Settings.WireFormat = WireFormat;
+    Settings.Address = IP;
+    Settings.Port = Port;
+    Settings.ConnectTimeoutSeconds = ConnectTimeoutSeconds;
+    Settings.InitialReconnectDelaySeconds = InitialReconnectDelaySeconds;
+    Settings.MaxReconnectDelaySeconds = MaxReconnectDelaySeconds;
+    Settings.Recorder = Recorder;
+    Settings.ClockSyncInterval = GetDefault<UHandTrackingSettings>()->ClockSyncInterval;
+
+    // 수신은 전용 스레드에서 처리합니다.
+    TUniquePtr<FHandTrackingReceiveWorker> ReceiveWorker = MakeUnique<FHandTrackingReceiveWorker>(Settings, MakeConnectionStateCallback());
+    if (!ReceiveWorker->Start())
+    {
+        UE_LOG(LogHandTracking, Error, TEXT("Failed to start hand tracking receive thread."));
+        return;
+    }
+    FrameSource = MoveTemp(ReceiveWorker);
+}
+
+void ASocketClient::StartReplay()
+{
+    FHandTrackingReplaySettings Settings;
+    Settings.FilePath = ReplayFilePath;
+    Settings.Pacing = ReplayPacing;
+    Settings.FixedRate = ReplayFixedRate;
+    Settings.bLoop = bLoopReplay;
+
+    TUniquePtr<FHandTrackingReplaySource> ReplaySource = MakeUnique<FHandTrackingReplaySource>(Settings, MakeConnectionStateCallback());
+    if (!ReplaySource->Open())
+    {
+        UE_LOG(LogHandTracking, Warning, TEXT("Could not open hand tracking recording '%s'."), *ReplayFilePath);
+        return;
+    }
+
+    // 녹화 당시의 전송 방식과 형식으로 프레임을 해석합니다.
+    FrameTransport = ReplaySource->GetRecordingHeader().Transport;
+    FrameWireFormat = ReplaySource->GetRecordingHeader().WireFormat;
+
+    if (!ReplaySource->Start())
+    {
+        UE_LOG(LogHandTracking, Error, TEXT("Failed to start hand tracking replay thread."));
+        return;
+    }
+    UE_LOG(LogHandTracking, Log, TEXT("Replaying hand tracking frames from '%s'."), *ReplayFilePath);
+    FrameSource = MoveTemp(ReplaySource);
+}
+
+IHandTrackingFrameSource::FConnectionStateCallback ASocketClient::MakeConnectionStateCallback()
+{
+    // 연결 상태 변경은 수신 스레드에서 오므로 게임 스레드로 넘겨서 알립니다.
+    // 이미 끊은 워커가 뒤늦게 보낸 알림은 세대 번호로 걸러냅니다.
+    TWeakObjectPtr<ASocketClient> WeakThis(this);
+    const int32 Generation = ConnectionGeneration;
+    return [WeakThis, Generation](EHandTrackingConnectionState NewState)
+    {
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, NewState]()
+        {
+            ASocketClient* Client = WeakThis.Get();
+            if (Client && Client->ConnectionGeneration == Generation)
+            {
+                Client->HandleConnectionStateChanged(NewState);
+            }
+        });
+    };
+}
+
+void ASocketClient::HandleConnectionStateChanged(EHandTrackingConnectionState NewState)
+{
+    if (ConnectionState == NewState)
+    {
+        return;
+    }
+
+    const bool bWasConnected = bIsConnected;
+    ConnectionState = NewState;
+    bIsConnected = (NewState == EHandTrackingConnectionState::Connected);
+    OnConnectionStateChanged.Broadcast(NewState);
+
+    // 새로 접속한 트래커는 이전에 보낸 요청을 모릅니다.
+    if (bIsConnected)
     {
-        //  ý ý  ߽ϴ.
-        UE_LOG(LogTemp, Error, TEXT("Could not get socket subsystem."));
+        RateController.ForceResend();
+    }
+
+    // 재생 소스는 파일 끝에서만 끊깁니다.
+    if (bWasConnected && !bIsConnected && Transport == EHandTrackingTransport::Replay && FrameSource && bExitWhenReplayFinished)
+    {
+        UE_LOG(LogHandTracking, Log, TEXT("Hand tracking replay finished (%d frames dropped), exiting."), GetReceiveStats().DroppedFrames);
+        FPlatformMisc::RequestExit(false);
     }
 }
 
 bool ASocketClient::SendData(const FString& Message)
 {
-    if(!Socket || Socket->GetConnectionState() != ESocketConnectionState::SCS_Connected)
+    if (!FrameSource)
     {
         return false;
     }
     
-    // ڿ UTF-8 ڵմϴ.
+    // 문자열을 UTF-8로 인코딩합니다.
     FTCHARToUTF8 Convert(*Message);
-    int32 BytesSent = 0;
+    TArray<uint8> Bytes(reinterpret_cast<const uint8*>(Convert.Get()), Convert.Length());
     
-    // ͸ ϰ  θ ȯմϴ.
-    bool bSuccess = Socket->Send((uint8*)Convert.Get(), Convert.Length(), BytesSent);
-    return bSuccess;
+    // 실제 전송은 수신 스레드가 처리합니다. 연결되어 있지 않으면 false
+    return FrameSource->Send(MoveTemp(Bytes));
+}
+
+bool ASocketClient::SendControlMessage(const FHandTrackingControlMessage& Message)
+{
+    if (!FrameSource || !HasBackChannel())
+    {
+        return false;
+    }
+
+    TArray<uint8> Bytes;
+    HandTrackingProtocol::EncodeControlMessage(Message, Bytes);
+    return FrameSource->Send(MoveTemp(Bytes));
+}
+
+void ASocketClient::ObserveDecodedFrame(const FHandTrackingFrame& Frame)
+{
+    if (bRateControlEnabled)
+    {
+        RateController.ObserveFrame(Frame, GetWantedHandMask());
+    }
+}
+
+void ASocketClient::UpdateRateControl(double Now, float FrameSeconds)
+{
+    if (!bRateControlEnabled || !bIsConnected || !HasBackChannel())
+    {
+        return;
+    }
+
+    FHandTrackingControlMessage Message;
+    if (RateController.Update(Now, FrameSeconds, GetWantedHandMask(), Message) && SendControlMessage(Message))
+    {
+        UE_LOG(LogHandTracking, Verbose, TEXT("Requested %.1f Hz from tracker %d (headroom %.2f)."), Message.RequestedRate, StreamId, Message.Headroom);
+    }
+}
+
+uint8 ASocketClient::GetWantedHandMask() const
+{
+    return (bWantLeftHand ? (1u << static_cast<int32>(EHandedness::Left)) : 0u)
+        | (bWantRightHand ? (1u << static_cast<int32>(EHandedness::Right)) : 0u);
+}
+
+bool ASocketClient::HasBackChannel() const
+{
+    return FrameTransport == EHandTrackingTransport::Tcp || FrameTransport == EHandTrackingTransport::Udp;
 }
 
 bool ASocketClient::ReceiveData(FString& OutMessage)
 {
-    if (!Socket || Socket->GetConnectionState() != ESocketConnectionState::SCS_Connected)
+    if (!FrameSource)
     {
         return false;
     }
 
-    //   մϴ.
-    const int32 BufferSize = 4096;
-    uint8 ReceiveBuffer[BufferSize];
-    int32 BytesRead = 0;
-    
-    // ͸ ϰ  θ Ȯմϴ.
-    bool bHasData = Socket->HasPendingData((uint32&)BytesRead);
-    if (bHasData && BytesRead > 0) // Ͱ ְ,  Ʈ 
+    // 수신 스레드가 쌓아 둔 프레임 중 가장 최근 것만 가져옵니다.
+    if (!FrameSource->PopLatestFrame(LatestFrameBuffer) || LatestFrameBuffer.Data.Num() == 0)
     {
-        bool bReceived = Socket->Recv(ReceiveBuffer, BufferSize, BytesRead, ESocketReceiveFlags::None);
-        if (bReceived && BytesRead > 0)
-        {
-            //  ͸ FString ȯմϴ.
-            // UTF8_TO_TCHAR ȯ    Ʈŭ óմϴ.
-            FString ReceivedString = FString(UTF8_TO_TCHAR(reinterpret_cast<char*>(ReceiveBuffer))).Left(BytesRead);
-            OutMessage = ReceivedString;
-            UE_LOG(LogTemp, Log, TEXT("Received Data: %s"), *OutMessage); // α ġ 
-            return true;
-        }
+        return false;
     }
 
-    return false; //  ſ ϸ false ȯ
+    // UDP 데이터그램 헤더는 건너뜁니다.
+    const int32 HeaderSize = (FrameTransport == EHandTrackingTransport::Udp) ? HandTrackingProtocol::DatagramHeaderSize : 0;
+
+    // 받은 바이트 수만큼만 UTF-8에서 변환합니다.
+    FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(LatestFrameBuffer.Data.GetData() + HeaderSize), LatestFrameBuffer.Data.Num() - HeaderSize);
+    OutMessage = FString(Converted.Length(), Converted.Get());
+    UE_LOG(LogHandTracking, VeryVerbose, TEXT("Received Data: %s"), *OutMessage); // 로그 위치 수정
+    return true;
+}
+
+bool ASocketClient::ReceiveHandFrame(FHandTrackingFrame& OutFrame)
+{
+    return PopPendingFrame() && DecodePendingFrame(OutFrame);
 }
 
+bool ASocketClient::PopPendingFrame()
+{
+    if (!FrameSource)
+    {
+        return false;
+    }
+
+    // 디코딩은 다른 스레드에서 돌 수 있으므로 프레임과 함께 시계 추정도 여기서 받아 둡니다.
+    ClockEstimate = FrameSource->GetClockEstimate();
+    return FrameSource->PopLatestFrame(LatestFrameBuffer);
+}
 
+bool ASocketClient::DecodePendingFrame(FHandTrackingFrame& OutFrame) const
+{
+    const TArray<uint8>& FrameData = LatestFrameBuffer.Data;
+    if (!HandTrackingProtocol::DecodeTransportFrame(FrameTransport, FrameWireFormat, FrameData.GetData(), FrameData.Num(), OutFrame))
+    {
+        return false;
+    }
 
+    OutFrame.ArrivalTime = LatestFrameBuffer.ArrivalTime;
+    OutFrame.StreamId = StreamId;
+    OutFrame.EngineCaptureTime = (ClockEstimate.IsValid() && OutFrame.CaptureTimestamp > 0.0) ? ClockEstimate.ToEngineTime(OutFrame.CaptureTimestamp) : 0.0;
+    return true;
+}
 
+uint32 ASocketClient::GetDroppedFrameCount() const
+{
+    return FrameSource ? static_cast<uint32>(FrameSource->GetStats().DroppedFrames) : 0;
+}
 
+FHandTrackingReceiveStats ASocketClient::GetReceiveStats() const
+{
+    return FrameSource ? FrameSource->GetStats() : FHandTrackingReceiveStats();
+}
 
+void ASocketClient::DisconnectFromServer()
+{
+    // 수신 스레드를 멈추면 소켓도 함께 닫힙니다.
+    if (FrameSource)
+    {
+        FrameSource->Shutdown();
+        FrameSource.Reset();
+    }
+    // 수신 스레드가 멈춘 뒤에 닫아야 녹화 파일이 온전히 남습니다.
+    Recorder.Reset();
+    ++ConnectionGeneration;
+    HandleConnectionStateChanged(EHandTrackingConnectionState::Disconnected);
+}
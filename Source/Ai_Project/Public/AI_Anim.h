@@ -4,10 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "HandTracking/HandTrackingTypes.h"
 #include "AI_Anim.generated.h"
 
-//DECLARE_LOG_CATEGORY_EXTERN(LogMyAnimInstance, Log, All);
-
 UCLASS()
 class AI_PROJECT_API UAI_Anim : public UAnimInstance
 {
@@ -15,8 +14,15 @@ class AI_PROJECT_API UAI_Anim : public UAnimInstance
 
 public:
 	
-	//virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	// 노드의 PreUpdate보다 먼저 스냅샷을 채운다. NativeUpdateAnimation은 노드가 복사한 뒤에 불려 한 프레임 늦는다.
+	virtual void PreUpdateAnimation(float DeltaSeconds) override;
+
+	// 이 메시가 맡은 손의 최신 자세. 게임 스레드에서만 읽는다 (FAnimNode_HandTrackingPose::PreUpdate).
+	const FHandTrackingPoseSnapshot& GetHandPoseSnapshot() const { return HandPoseSnapshot; }
+
+private:
+	// 폰이 이번 틱에 적용한 손 자세를 복사한다.
+	void UpdateHandPoseSnapshot();
 
-	//FVector CalculateIKPosition(const class AAI_Pawn* Pawn, int32 LandmarkId);
-	//void SetIKTarget(const FName& BoneName, const FVector& IKPosition);
+	FHandTrackingPoseSnapshot HandPoseSnapshot;
 };
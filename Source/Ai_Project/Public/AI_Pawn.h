@@ -5,6 +5,11 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h" 
+#include "HandTracking/HandTrackingTypes.h"
+#include "HandTracking/HandTrackingCalibration.h"
+#include "HandTracking/HandTrackingLatencyTracker.h"
+#include "HandTracking/HandTrackingPosePipeline.h"
+#include "HandTracking/HandTrackingSubsystem.h"
 #include "AI_Pawn.generated.h"
 
 UCLASS()
@@ -19,6 +24,7 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	// Called every frame
@@ -45,27 +51,72 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Player Settings | Player")
 	class USkeletalMeshComponent* RightHandMesh;
 
-    // 본 ID에 따라 본 이름 가져오기
+    // 본 ID에 따라 본 이름 가져오기 (애님 블루프린트용, HandType은 "Left" 또는 "Right")
 	UFUNCTION(BlueprintCallable, Category = "Hand Tracking")
 	FName GetBoneNameFromLandmarkId(int32 LandmarkId, const FString& HandType) const;
-	// 웹캠 데이터 파싱 및 핸드 트래킹 데이터 적용
-	void ParseAndApplyHandTrackingData(const FString& ReceivedData);
+	FName GetBoneName(int32 LandmarkId, EHandedness Handedness) const;
+	class USkeletalMeshComponent* GetHandMesh(EHandedness Handedness) const;
+	// 파이프라인이 구한 자세를 핸드 메시와 손가락 자세에 적용 (게임 스레드에 남은 유일한 단계)
+	void ApplyPoseSnapshot(const FHandTrackingPipelineSnapshot& Snapshot);
+	// UHandTrackingSubsystem이 이 폰의 스트림 프레임을 파이프라인에 넣기 직전 (액터 틱이 끝난 뒤)
+	void OnHandTrackingFrameQueued();
+	// 다음 틱에 적용할 자세의 표시 시각. 다음 틱까지 한 프레임, 화면에 나오기까지 DisplayLatencyFrames
+	double GetNextDisplayTime(float DeltaTime) const;
+	// 적용이 끝난 프레임의 지연 시간을 집계하고 stat 카운터를 갱신 (CaptureTime은 엔진 시계, 모르면 0)
+	void RecordFrameLatency(double ArrivalTime, double CaptureTime);
     // 웹캠 데이터로부터 언리얼 엔진 좌표계로 변환
 	FVector ConvertPythonToUnreal(float PixelX, float PixelY, float PixelZ);	
-    // 웹캠 데이터를 기반으로 핸드 메시 위치 업데이트
+	// 트래커 -> 언리얼 보정 변환 (BeginPlay에서 UHandTrackingSettings로부터 읽는다)
+	FHandTrackingCalibration Calibration;
+    // 웹캠 데이터를 기반으로 핸드 메시 위치 업데이트 (손마다 트랜스폼 갱신 한 번, 변화가 작으면 건너뜀)
 	UFUNCTION(BlueprintCallable, Category="Hand Tracking")
-	void UpdateHandMeshPosition(const FString& HandType, const FVector& NewPosition, const FRotator& NewRotation);
-	UFUNCTION(BlueprintCallable, Category="Hand Tracking")
-	void UpdateBonePositions(const TMap<int32, FVector>& BoneIdToPositionMap, const FString& HandType);
+	void UpdateHandMeshPosition(EHandedness Handedness, const FVector& NewPosition, const FRotator& NewRotation);
 	
-	// 랜드마크 좌표 저장 맴버 변수 
-	TMap<int32, FVector> LandmarkIdToPositionMap;
+	// 손별로 마지막에 적용한 랜드마크 (언리얼 좌표, 필터/예측을 거친 값, EHandedness 값으로 인덱싱)
+	FHandFrame LatestHands[MaxTrackedHands];
+	// 변환 -> 필터 -> 지터 버퍼 -> 손가락 IK (BeginPlay에서 만들어 UHandTrackingSubsystem에 등록한다)
+	TSharedPtr<FHandTrackingPosePipeline, ESPMode::ThreadSafe> HandPosePipeline;
+	// 파이프라인에 넣은 프레임 수와, 적용한 자세가 반영한 프레임 수
+	uint32 QueuedFrameCount = 0;
+	uint32 AppliedFrameCount = 0;
+	// 마지막으로 적용한 자세의 손별 지터 버퍼 통계
+	FHandTrackingJitterBufferStats LatestJitterStats[MaxTrackedHands];
+	// UHandTrackingSettings에서 BeginPlay에 읽는다.
+	float DisplayLatencyFrames = 1.0f;
+	float HandPositionEpsilon = 0.01f;
+	float HandRotationEpsilon = 0.05f;
+	// LatestHands에서 푼 손바닥 회전과 손가락 관절 각도 (EHandedness 값으로 인덱싱)
+	FHandTrackingHandPose LatestHandPoses[MaxTrackedHands];
+	// 신뢰도가 이보다 낮은 랜드마크가 낀 손가락은 풀지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HandTracking", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float MinLandmarkConfidence = 0.5f;
 	
 	FVector ReferencePosition; // 기준점 위치
 	bool bHasReference = false; // 기준점이 설정되었는지 여부
 	
-	UPROPERTY()
-	class ASocketClient* SocketClient;	
+	// 트래커 연결 상태 변경 알림 (UHandTrackingSubsystem::OnConnectionStateChanged)
+	UFUNCTION()
+	void OnTrackingConnectionStateChanged(EHandTrackingConnectionState NewState);
+	bool bTrackingConnected = false;
+	// 이 폰이 맡을 트래커 스트림 (ASocketClient::StreamId). 스테이션마다 폰 하나, 스트림 하나
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "HandTracking")
+	int32 HandTrackingStreamId = 0;
+
+	// 트래커 캡처 시각부터 손 위치 적용까지 (트래커와 시계를 맞췄거나, 트래커가 FPlatformTime::Seconds와 같은 시계를 쓸 때만 집계)
+	UFUNCTION(BlueprintCallable, Category = "Hand Tracking")
+	FHandTrackingLatencyStats GetCaptureToApplyLatency() const { return CaptureToApplyLatency.GetStats(); }
+	// 트래커 캡처 시각부터 수신 스레드 도착까지 (카메라, 추론, 네트워크. 집계 조건은 위와 같다)
+	UFUNCTION(BlueprintCallable, Category = "Hand Tracking")
+	FHandTrackingLatencyStats GetCaptureToReceiveLatency() const { return CaptureToReceiveLatency.GetStats(); }
+	// 수신 스레드 도착부터 손 위치 적용까지
+	UFUNCTION(BlueprintCallable, Category = "Hand Tracking")
+	FHandTrackingLatencyStats GetReceiveToApplyLatency() const { return ReceiveToApplyLatency.GetStats(); }
+	// 손별 지터 버퍼 언더플로/오버플로
+	UFUNCTION(BlueprintCallable, Category = "Hand Tracking")
+	FHandTrackingJitterBufferStats GetJitterBufferStats(EHandedness Handedness) const { return LatestJitterStats[static_cast<int32>(Handedness)]; }
+	FHandTrackingLatencyTracker CaptureToApplyLatency;
+	FHandTrackingLatencyTracker CaptureToReceiveLatency;
+	FHandTrackingLatencyTracker ReceiveToApplyLatency;
 	FVector InitialCameraLocation;     // 초기 카메라 위치
 	FVector HandMeshOffsetFromCamera; // 카메라로부터 핸드 메시까지의 상대적 거리
 
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BoneControllers/AnimNode_SkeletalControlBase.h"
+#include "HandTracking/HandTrackingTypes.h"
+#include "AnimNode_HandTrackingPose.generated.h"
+
+/**
+ * 랜드마크에서 푼 손 자세(FHandTrackingHandPose)를 손 본과 손가락 본에 컴포넌트 공간에서 적용한다.
+ * 손 자세는 게임 스레드의 PreUpdate에서 UAI_Anim의 스냅샷(같은 틱의 UAI_Anim::PreUpdateAnimation에서 채움)을 복사해 두고, 평가는 애니메이션 워커 스레드에서 한다.
+ * 손 본은 현재 포즈의 손바닥 축이 트래킹한 손바닥 축과 맞도록 돌리고,
+ * 손가락 마디는 뿌리부터 관절 각도가 가리키는 방향을 향하게 돌리며 그 회전을 끝 쪽 본에 전파한다.
+ */
+USTRUCT(BlueprintInternalUseOnly)
+struct AI_PROJECT_API FAnimNode_HandTrackingPose : public FAnimNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+	// FAnimNode_Base
+	virtual bool HasPreUpdate() const override { return true; }
+	virtual void PreUpdate(const UAnimInstance* InAnimInstance) override;
+
+	// FAnimNode_SkeletalControlBase
+	virtual void EvaluateSkeletalControl_AnyThread(FComponentSpacePoseContext& Output, TArray<FBoneTransform>& OutBoneTransforms) override;
+	virtual bool IsValidToEvaluate(const USkeleton* Skeleton, const FBoneContainer& RequiredBones) override;
+
+private:
+	virtual void InitializeBoneReferences(const FBoneContainer& RequiredBones) override;
+
+	static constexpr int32 NumFingers = FHandTrackingHandPose::NumFingers;
+	// 손가락마다 본이 있는 랜드마크 3개 (끝 랜드마크는 방향 목표로만 쓴다)
+	static constexpr int32 BonesPerFinger = 3;
+
+	struct FFingerChain
+	{
+		int32 FirstLandmark = 0;
+		FBoneReference Bones[BonesPerFinger];
+		// 본 로컬 공간에서 다음 마디를 향하는 축 (참조 포즈 기준)
+		FVector LocalAxes[BonesPerFinger];
+		bool bValid = false;
+	};
+
+	// [EHandedness][손가락]. 스켈레톤 하나에 양손 본이 다 있으므로 둘 다 찾아 두고 스냅샷의 손으로 고른다.
+	FFingerChain FingerChains[MaxTrackedHands][NumFingers];
+	FBoneReference HandRootBones[MaxTrackedHands];
+
+	FHandTrackingPoseSnapshot Snapshot;
+};
@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 랜드마크 ID -> 스켈레톤 본 이름 표. 이름 표는 컴파일 타임 상수이고 FName은 처음 쓸 때 한 번만 만든다.
+ * 본 인덱스는 FAnimNode_HandTrackingPose가 FBoneReference로 필요한 본만 InitializeBoneReferences에서 찾아 두므로
+ * 프레임마다 이름으로 본을 찾지 않는다.
+ */
+class AI_PROJECT_API FHandTrackingBoneMap
+{
+public:
+	// 랜드마크에 대응하는 본 이름. 매핑되지 않았으면 NAME_None
+	static FName GetBoneName(EHandedness Handedness, int32 LandmarkId);
+	// 손가락 본들의 공통 조상인 손 본 (손목 회전을 적용하는 본)
+	static FName GetHandRootBoneName(EHandedness Handedness);
+};
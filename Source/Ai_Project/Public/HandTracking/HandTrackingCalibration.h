@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 트래커 좌표 -> 언리얼 좌표 아핀 변환. 손 하나의 랜드마크를 SoA 그대로 4개씩 SIMD로 변환한다.
+ * 보정 값은 UHandTrackingSettings에서 읽는다.
+ */
+class AI_PROJECT_API FHandTrackingCalibration
+{
+public:
+	// 항등 변환. 보정 값은 FromSettings로 읽는다 (CDO 생성 중에는 설정 객체를 건드리지 않는다).
+	FHandTrackingCalibration();
+	explicit FHandTrackingCalibration(const FMatrix44f& InMatrix);
+
+	static FHandTrackingCalibration FromSettings();
+
+	// 21개 랜드마크를 한 번에 변환. 유효 비트와 신뢰도는 그대로 복사한다. In과 Out이 같아도 된다.
+	void TransformHand(const FHandFrame& In, FHandFrame& Out) const;
+	// 점 하나 변환 (디버깅/블루프린트용)
+	FVector3f TransformPosition(const FVector3f& Position) const { return Matrix.TransformPosition(Position); }
+
+	const FMatrix44f& GetMatrix() const { return Matrix; }
+
+private:
+	FMatrix44f Matrix;
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 핑/응답 왕복으로 트래커 시계와 엔진 시계(FPlatformTime::Seconds)의 차이와 흐름(drift)을 추정한다. 연결마다 하나, I/O 스레드 전용
+ *
+ * 핑 t0(엔진) -> 트래커 수신 t1, 응답 t2(트래커) -> 엔진 수신 t3에서
+ *   오프셋 = ((t1 - t0) + (t2 - t3)) / 2,  왕복 = (t3 - t0) - (t2 - t1)
+ * 오프셋 오차는 가는 길과 오는 길의 지연 차이에서 오므로, NTP처럼 최근 표본 중 왕복이 짧은 것만 골라 쓴다.
+ * 고른 표본이 DriftMinSpan 넘게 퍼져 있으면 오프셋을 시간에 대한 직선으로 맞춰 두 시계의 흐름 차이도 따라간다.
+ */
+class AI_PROJECT_API FHandTrackingClockSync
+{
+public:
+	// 응답 하나를 더한다. ReceiveTime은 응답을 받은 엔진 시각(초). 추정이 바뀌었으면 true
+	bool AddReply(const FHandTrackingClockReply& Reply, double ReceiveTime);
+
+	// 트래커가 다시 시작했을 때 등
+	void Reset();
+
+	const FHandTrackingClockEstimate& GetEstimate() const { return Estimate; }
+	int32 GetNumSamples() const { return NumSamples; }
+
+	// 기억하는 최근 표본 수
+	static constexpr int32 MaxSamples = 32;
+	// 추정에 쓰는 왕복이 짧은 표본의 비율
+	static constexpr int32 BestSampleDivisor = 4;
+	// 고른 표본이 이 시간(초)보다 넓게 퍼져 있을 때만 흐름을 추정한다.
+	static constexpr double DriftMinSpan = 5.0;
+	// 흐름 추정값의 상한. 수정 발진기는 보통 100ppm 안쪽이다.
+	static constexpr double MaxDrift = 1.0e-3;
+	// 새 표본의 오프셋이 추정에서 이만큼(초) 넘게 벗어나면 트래커 시계가 바뀐 것으로 보고 새로 시작한다.
+	static constexpr double StepThreshold = 1.0;
+
+private:
+	struct FSample
+	{
+		// 핑과 응답 수신의 가운데 엔진 시각
+		double Time = 0.0;
+		double Offset = 0.0;
+		double RoundTrip = 0.0;
+	};
+
+	void UpdateEstimate();
+
+	FSample Samples[MaxSamples];
+	int32 NumSamples = 0;
+	int32 NextSample = 0;
+
+	FHandTrackingClockEstimate Estimate;
+};
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 양자화 + 키프레임/델타로 줄인 랜드마크 프레임 (EHandTrackingWireFormat::Compact).
+ * 좌표는 2^-FractionBits 단위 int16로 양자화한다. 정규화 좌표를 보내는 트래커는 13 (1/8192, 1920px 카메라에서 약 0.25px, 범위 ±4),
+ * 픽셀 좌표를 보내는 트래커는 4 (1/16px, 범위 ±2048)가 알맞다.
+ * KeyframeInterval 프레임마다 키프레임을 보내고, 그 사이에는 키프레임보다 DeltaThreshold 넘게 움직인 랜드마크만 델타로 보낸다.
+ * 델타는 바로 앞 프레임이 아니라 키프레임 기준이라, 중간 프레임이 빠지거나 최신 프레임만 남겨도 풀 수 있다.
+ * 신뢰도는 랜드마크마다 1바이트 (0~255 -> 0~1)로 실어 수신 쪽 MinLandmarkConfidence가 JSON, Binary와 똑같이 걸린다.
+ *
+ * 압축 프레임 (리틀 엔디언, 버전 2)
+ *   0  uint32  FrameSize       이 필드를 포함한 프레임 전체 바이트 수
+ *   4  uint16  Magic           'H' 'C'
+ *   6  uint8   Version         2
+ *   7  uint8   Flags           bit0 = 키프레임
+ *   8  uint64  CaptureTimeUs   트래커 기준 캡처 시각 (마이크로초)
+ *  16  uint16  KeyframeId      키프레임: 자기 번호, 델타: 기준 키프레임 번호
+ *  18  uint8   HandCount       0 ~ MaxTrackedHands
+ *  19  uint8   FractionBits    양자화 단위 2^-FractionBits. 델타는 키프레임과 같다.
+ *  20  손 HandCount개
+ *        키프레임: uint8 Handedness, uint8[3] ValidMask, int16[21] X, int16[21] Y, int16[21] Z, uint8[21] Confidence
+ *        델타:     uint8 Handedness, uint8[3] ChangedMask, 바뀐 랜드마크의 dX들, dY들, dZ들 (지그재그 varint), Confidence들 (uint8)
+ *      델타는 좌표가 DeltaThreshold 넘게 움직였거나 신뢰도가 ConfidenceThreshold 넘게 바뀐 랜드마크를 담는다.
+ *      델타의 손은 키프레임과 같은 순서, 같은 손이다. 손 구성이 바뀌면 인코더가 키프레임을 보낸다.
+ *
+ * 성분별로 모아 두어 비슷한 크기의 작은 정수가 이어지므로 varint 대부분이 1~2바이트이고, 그 뒤에 범용 압축을 걸어도 잘 줄어든다.
+ *
+ * 수신 쪽 I/O 스레드는 마지막 키프레임을 기억해 두었다가 델타 앞에 붙여 [키프레임][델타]를 프레임 하나로 내보낸다.
+ * 그래서 디코더에는 상태가 없고, 어느 스레드에서든 받은 프레임 하나만 보고 푼다.
+ */
+namespace HandTrackingCompactCodec
+{
+	constexpr uint16 Magic = 0x4348;
+	constexpr uint8 Version = 2;
+	constexpr uint8 KeyframeFlag = 0x01;
+	constexpr int32 HeaderSize = 20;
+	constexpr int32 MaxFractionBits = 14;
+	constexpr int32 KeyframeHandSize = 4 + HandLandmarkCount * (3 * sizeof(int16) + sizeof(uint8));
+	// int16 차이는 지그재그로 17비트라 varint 하나가 최대 3바이트, 신뢰도 1바이트
+	constexpr int32 MaxDeltaHandSize = 4 + HandLandmarkCount * (3 * 3 + 1);
+	constexpr int32 MaxFrameSize = HeaderSize + MaxTrackedHands * MaxDeltaHandSize;
+
+	// 양자화한 손 하나
+	struct FQuantizedHand
+	{
+		EHandedness Handedness = EHandedness::Right;
+		uint32 ValidMask = 0;
+		int16 X[HandLandmarkCount] = {};
+		int16 Y[HandLandmarkCount] = {};
+		int16 Z[HandLandmarkCount] = {};
+		// 0 ~ 255 (0 ~ 1)
+		uint8 Confidence[HandLandmarkCount] = {};
+	};
+
+	AI_PROJECT_API void Quantize(const FHandFrame& Hand, int32 FractionBits, FQuantizedHand& OutHand);
+
+	// 프레임 헤더만 읽는다. 헤더가 올바르지 않거나 Size가 FrameSize보다 작으면 false
+	AI_PROJECT_API bool ReadHeader(const uint8* Data, int32 Size, int32& OutFrameSize, bool& bOutKeyframe, uint16& OutKeyframeId);
+
+	// Frame을 키프레임 하나로 OutBytes 뒤에 붙인다. 붙인 바이트 수를 반환
+	AI_PROJECT_API int32 EncodeKeyframe(const FHandTrackingFrame& Frame, uint16 KeyframeId, int32 FractionBits, TArray<uint8>& OutBytes);
+
+	// 키프레임 하나, 또는 키프레임 바로 뒤에 그 키프레임을 기준으로 한 델타가 붙은 바이트를 푼다. 스레드 안전
+	AI_PROJECT_API bool DecodeFrame(const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame);
+}
+
+struct FHandTrackingCompactEncoderSettings
+{
+	// 키프레임 간격(프레임). 1이면 모두 키프레임
+	int32 KeyframeInterval = 30;
+	// 양자화 단위 2^-FractionBits (0~14). 정규화 좌표 13, 픽셀 좌표 4
+	int32 FractionBits = 13;
+	// 키프레임보다 이만큼 넘게 움직인 랜드마크만 델타에 넣는다 (트래커 좌표 단위, 기본은 정규화 좌표로 약 1px)
+	float DeltaThreshold = 0.0005f;
+	// 키프레임보다 신뢰도가 이만큼 넘게 바뀐 랜드마크도 델타에 넣는다 (0~1)
+	float ConfidenceThreshold = 0.02f;
+};
+
+/**
+ * 송신 쪽 압축 인코더. 스트림마다 하나씩 두고 프레임을 순서대로 넣는다.
+ */
+class AI_PROJECT_API FHandTrackingCompactEncoder
+{
+public:
+	explicit FHandTrackingCompactEncoder(const FHandTrackingCompactEncoderSettings& InSettings = FHandTrackingCompactEncoderSettings());
+
+	// Frame을 키프레임이나 델타로 OutBytes 뒤에 붙인다. 붙인 바이트 수를 반환
+	int32 Encode(const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes);
+
+	// 다음 프레임을 키프레임으로 보낸다 (받는 쪽이 새로 접속했을 때 등).
+	void ForceKeyframe() { bHasKeyframe = false; }
+
+private:
+	// 손 구성(손 수, 순서, 유효 랜드마크)이 키프레임과 같으면 true
+	bool MatchesKeyframe(const HandTrackingCompactCodec::FQuantizedHand* Hands, int32 NumHands) const;
+
+	FHandTrackingCompactEncoderSettings Settings;
+	int32 ThresholdQuanta = 0;
+	int32 ConfidenceThresholdQuanta = 0;
+
+	HandTrackingCompactCodec::FQuantizedHand KeyframeHands[MaxTrackedHands];
+	int32 NumKeyframeHands = 0;
+	uint16 KeyframeId = 0;
+	int32 FramesSinceKeyframe = 0;
+	bool bHasKeyframe = false;
+};
+
+/**
+ * 수신 쪽 I/O 스레드에서 마지막 키프레임을 기억해 델타 프레임을 혼자 풀 수 있는 프레임으로 만든다.
+ * 최신 프레임만 남기고 버리는 단계보다 앞에서 모든 프레임을 Observe해야 중간에 버려진 키프레임도 놓치지 않는다.
+ */
+class AI_PROJECT_API FHandTrackingCompactKeyframeCache
+{
+public:
+	// 압축 프레임 하나를 본다. 키프레임이면 복사해 둔다.
+	void Observe(const uint8* Data, int32 Size);
+
+	// Data가 키프레임이면 그대로, 델타면 기준 키프레임 뒤에 붙여 OutFrame 뒤에 붙인다. 기준 키프레임이 없으면 false
+	bool Resolve(const uint8* Data, int32 Size, TArray<uint8>& OutFrame) const;
+
+	void Reset();
+
+private:
+	TArray<uint8> Keyframe;
+	uint16 KeyframeId = 0;
+};
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 21개 랜드마크를 손바닥 회전과 손가락 관절 각도로 바꾸는 해석적 IK.
+ * 손바닥 좌표계는 손목, 검지/중지/새끼 뿌리로 정한다.
+ * 손가락마다 뿌리 마디는 손바닥 좌표계에서 바로 각도를 읽는다. 가운데/끝 마디는 손가락 평면에서
+ * 2본 IK(코사인 법칙)로 풀고, 굽는 방향은 가운데 관절이 현 어느 쪽에 있는지로 정한다.
+ * 모든 손의 손가락 체인을 SIMD 레인 하나씩에 배치해 한 번에 푼다.
+ */
+namespace HandTrackingFingerSolver
+{
+	// 손바닥 축. 네 점이 한 직선 위에 있으면 false
+	AI_PROJECT_API bool ComputePalmAxes(const FVector3f& Wrist, const FVector3f& IndexBase, const FVector3f& MiddleBase, const FVector3f& PinkyBase,
+		FVector3f& OutX, FVector3f& OutY, FVector3f& OutZ);
+
+	// Hands[i] -> OutPoses[i]. NumHands는 MaxTrackedHands 이하. 신뢰도가 MinConfidence보다 낮은 랜드마크가 낀 손가락은 풀지 않는다.
+	AI_PROJECT_API void Solve(const FHandFrame* Hands, int32 NumHands, float MinConfidence, FHandTrackingHandPose* OutPoses);
+}
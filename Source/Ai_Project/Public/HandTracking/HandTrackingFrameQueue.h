@@ -0,0 +1,46 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingFrameRing.h"
+#include "HandTracking/HandTrackingFrameSource.h"
+
+class FHandTrackingRecorder;
+
+/**
+ * 생산자 스레드(소켓 수신, 리플레이 등)가 게임 스레드로 최신 프레임을 넘기는 창구.
+ * 링이 가득 차면 가장 최근 프레임 하나만 들고 있다가 자리가 나면 넣고, 그 사이 밀린 프레임은 버린 것으로 센다.
+ */
+class AI_PROJECT_API FHandTrackingFrameQueue
+{
+public:
+	// 생산자 전용. 이 시점을 도착 시각으로 남기고, 녹화 중이면 함께 기록한다.
+	void Publish(const uint8* Data, int32 Size);
+	// 생산자 전용. 링이 가득 차서 들고 있던 프레임을 다시 넣어 본다.
+	void FlushPending();
+
+	// 소비자 전용
+	bool PopLatest(FHandTrackingRawFrame& OutFrame);
+
+	// 게임 스레드가 아직 가져가지 않은 프레임이 없으면 true
+	bool IsDrained() const { return !bHasPendingFrame && FrameRing.IsEmpty(); }
+
+	void AddDroppedFrames(uint32 Count) { DroppedFrameCount.fetch_add(Count, std::memory_order_relaxed); }
+	uint32 GetDroppedFrameCount() const { return DroppedFrameCount.load(std::memory_order_relaxed); }
+
+	void SetRecorder(TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> InRecorder) { Recorder = MoveTemp(InRecorder); }
+
+private:
+	static constexpr uint32 RingCapacity = 8;
+
+	THandTrackingFrameRing<FHandTrackingRawFrame, RingCapacity> FrameRing;
+
+	// 링이 가득 찼을 때 다음 기회까지 들고 있는 최신 프레임 (생산자 전용)
+	FHandTrackingRawFrame PendingFrame;
+	std::atomic<bool> bHasPendingFrame{false};
+
+	std::atomic<uint32> DroppedFrameCount{0};
+
+	TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> Recorder;
+};
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * 수신 스레드(생산자) 하나와 게임 스레드(소비자) 하나 사이의 락프리 링 버퍼.
+ * 슬롯은 Swap으로 주고받기 때문에 TArray 같은 버퍼를 넣어도 평상시에는 힙 할당이 없다.
+ * 소비자는 항상 가장 최근 프레임만 꺼내고, 그 사이에 쌓인 오래된 프레임은 버린다.
+ */
+template <typename FrameType, uint32 Capacity>
+class THandTrackingFrameRing
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+public:
+	THandTrackingFrameRing() = default;
+	THandTrackingFrameRing(const THandTrackingFrameRing&) = delete;
+	THandTrackingFrameRing& operator=(const THandTrackingFrameRing&) = delete;
+
+	// 생산자 전용: InOutFrame을 빈 슬롯과 교환해 넣는다. 링이 가득 차 있으면 false를 반환하고 InOutFrame은 그대로 둔다.
+	bool TryPush(FrameType& InOutFrame)
+	{
+		const uint32 Head = HeadIndex.load(std::memory_order_relaxed);
+		const uint32 Tail = TailIndex.load(std::memory_order_acquire);
+		if (Head - Tail >= Capacity)
+		{
+			return false;
+		}
+
+		Swap(Slots[Head & IndexMask], InOutFrame);
+		HeadIndex.store(Head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// 소비자 전용: 가장 최근 프레임을 OutFrame과 교환하고 나머지는 모두 버린다. O(1)
+	bool PopLatest(FrameType& OutFrame, uint32* OutSkippedCount = nullptr)
+	{
+		const uint32 Tail = TailIndex.load(std::memory_order_relaxed);
+		const uint32 Head = HeadIndex.load(std::memory_order_acquire);
+		if (Head == Tail)
+		{
+			return false;
+		}
+
+		Swap(OutFrame, Slots[(Head - 1) & IndexMask]);
+		if (OutSkippedCount)
+		{
+			*OutSkippedCount = Head - Tail - 1;
+		}
+		TailIndex.store(Head, std::memory_order_release);
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		return HeadIndex.load(std::memory_order_acquire) == TailIndex.load(std::memory_order_acquire);
+	}
+
+private:
+	static constexpr uint32 IndexMask = Capacity - 1;
+
+	FrameType Slots[Capacity];
+
+	// 생산자와 소비자가 서로 다른 캐시 라인의 인덱스를 쓰도록 분리
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> HeadIndex{0};
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> TailIndex{0};
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+// 디코딩 전 원본 프레임과 수신 시각
+struct FHandTrackingRawFrame
+{
+	TArray<uint8> Data;
+	// 프레임이 이쪽에 도착한 시각 (FPlatformTime::Seconds)
+	double ArrivalTime = 0.0;
+};
+
+/**
+ * ASocketClient가 프레임을 받아 오는 곳 (소켓 수신 스레드, 공유 메모리 등).
+ * 게임 스레드는 어느 전송 방식이든 PopLatestFrame으로 가장 최근 원본 프레임만 가져간다.
+ */
+class AI_PROJECT_API IHandTrackingFrameSource
+{
+public:
+	// 연결 상태가 바뀔 때 프레임을 만드는 스레드에서 호출된다.
+	using FConnectionStateCallback = TFunction<void(EHandTrackingConnectionState)>;
+
+	virtual ~IHandTrackingFrameSource() = default;
+
+	// 게임 스레드 전용. 새 프레임이 없으면 false
+	virtual bool PopLatestFrame(FHandTrackingRawFrame& OutFrame) = 0;
+
+	virtual FHandTrackingReceiveStats GetStats() const = 0;
+
+	// 트래커로 보낼 데이터. 역방향 채널이 없는 전송 방식은 false
+	virtual bool Send(TArray<uint8>&& Data) { return false; }
+
+	virtual EHandTrackingConnectionState GetConnectionState() const = 0;
+
+	// 트래커 시계 -> 엔진 시계 추정. 시계를 맞추지 않는 전송 방식이나 아직 응답이 없으면 IsValid()가 false
+	virtual FHandTrackingClockEstimate GetClockEstimate() const { return FHandTrackingClockEstimate(); }
+
+	virtual void Shutdown() = 0;
+};
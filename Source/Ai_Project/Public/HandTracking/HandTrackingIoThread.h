@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+
+class FRunnableThread;
+class FEvent;
+class FHandTrackingReceiveWorker;
+
+/**
+ * 모든 트래커 소켓을 스레드 하나에서 돌린다. 스트림이 몇 개든 수신 스레드는 하나다.
+ * 워커는 논블로킹 상태 기계라 한 바퀴에 모든 소켓을 한 번씩 확인하고, 아무 일도 없던 바퀴 뒤에는 최대 1ms 쉰다.
+ * (FSocket에 여러 소켓을 한꺼번에 기다리는 API가 없어서 짧은 주기로 훑는다. 송신이 생기면 Wake로 바로 깨운다.)
+ * 첫 워커가 Acquire할 때 스레드를 띄우고, 마지막 참조가 사라질 때 멈춘다.
+ */
+class AI_PROJECT_API FHandTrackingIoThread : public FRunnable
+{
+public:
+	// 스레드를 띄우지 못했으면 null
+	static TSharedPtr<FHandTrackingIoThread, ESPMode::ThreadSafe> Acquire();
+
+	virtual ~FHandTrackingIoThread() override;
+
+	void Register(FHandTrackingReceiveWorker* Worker);
+	// 돌아온 뒤에는 이 스레드가 Worker를 더 이상 건드리지 않는다.
+	void Unregister(FHandTrackingReceiveWorker* Worker);
+	// 쉬고 있는 스레드를 바로 깨운다 (보낼 데이터가 생겼을 때).
+	void Wake();
+
+	int32 GetNumWorkers() const;
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	FHandTrackingIoThread();
+	bool Start();
+
+	mutable FCriticalSection WorkersLock;
+	TArray<FHandTrackingReceiveWorker*> Workers;
+
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	std::atomic<bool> bStopRequested{false};
+};
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 손 하나의 최근 프레임을 캡처 시각 순으로 쌓아 두고, 렌더 프레임마다 원하는 재생 시각을 감싸는 두 프레임 사이를 보간해 꺼낸다.
+ * 트래커(30 Hz)와 렌더(90 Hz 이상) 주기를 떼어 놓고, 도착 간격이 흔들려도 재생 지연 안에서는 매끄럽게 움직인다.
+ * 고정 크기 원형 버퍼라 힙 할당이 없다. 게임 스레드 전용
+ */
+class AI_PROJECT_API FHandTrackingJitterBuffer
+{
+public:
+	static constexpr int32 Capacity = 16;
+
+	enum class ESampleResult : uint8
+	{
+		// 받은 프레임이 없다.
+		Empty,
+		// 재생 시각을 감싸는 두 프레임 사이를 보간했다 (가장 새 프레임 시각과 같으면 그 프레임).
+		Interpolated,
+		// 재생 시각이 가장 오래된 프레임보다 앞이라 그 프레임을 그대로 냈다 (시작 직후).
+		BeforeOldest,
+		// 재생 시각이 가장 새 프레임을 지났다. 가장 새 프레임을 냈고, 호출한 쪽이 외삽할지 정한다.
+		Underflow,
+	};
+
+	// 캡처 시각 순서에 맞게 끼워 넣는다. 이미 재생한 시각보다 오래된 프레임은 버리고, 가득 차면 가장 오래된 프레임을 밀어낸다.
+	void Push(const FHandFrame& Hand, double CaptureTime);
+	// PlayoutTime의 손. 보간에 더 이상 쓰지 않을 앞쪽 프레임은 여기서 버린다.
+	ESampleResult Sample(double PlayoutTime, FHandFrame& OutHand);
+
+	int32 Num() const { return NumFrames; }
+	FHandTrackingJitterBufferStats GetStats() const;
+	void Reset();
+
+	// 이미 재생한 시각보다 이만큼 이상 오래된 프레임이 오면 트래커가 재시작한 것으로 보고 비운다(초).
+	static constexpr double RestartThreshold = 1.0;
+
+private:
+	int32 GetSlot(int32 Index) const { return (Head + Index) % Capacity; }
+
+	FHandFrame Frames[Capacity];
+	double Times[Capacity] = {};
+	int32 Head = 0;
+	int32 NumFrames = 0;
+
+	double LastPlayoutTime = 0.0;
+	bool bHasPlayedOut = false;
+
+	int32 Underflows = 0;
+	int32 Overflows = 0;
+	int32 LateFrames = 0;
+};
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * {"hands":[{"type":..,"landmarks":[{"id":..,"x":..,"y":..,"z":..}]}]} 형식 전용 JSON 파서.
+ * JSON 트리를 만들지 않고 텍스트를 한 번 훑으면서 FHandTrackingFrame에 바로 쓴다. 프레임당 힙 할당이 없다.
+ * 키 순서와 공백, 모르는 키는 상관없지만 형식이 다르면(값의 타입이 다르거나 이스케이프된 키 등) false를 반환하므로
+ * 호출하는 쪽은 FJsonSerializer 기반 파서로 다시 시도해야 한다. (HandTrackingProtocol::ParseJsonFrame 참고)
+ */
+namespace HandTrackingJsonParser
+{
+	// 트래커가 보낸 UTF-8 바이트 그대로
+	AI_PROJECT_API bool TryParseFrame(const ANSICHAR* Text, int32 Length, FHandTrackingFrame& OutFrame);
+	AI_PROJECT_API bool TryParseFrame(const TCHAR* Text, int32 Length, FHandTrackingFrame& OutFrame);
+}
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 최근 WindowSize개 지연 시간 표본으로 p50/p95/p99를 낸다.
+ * 표본은 고정 크기 원형 버퍼에 쌓고, 분포는 GetStats를 부를 때 새 표본이 있을 때만 다시 계산한다. 힙 할당 없음
+ * 게임 스레드 전용
+ */
+class AI_PROJECT_API FHandTrackingLatencyTracker
+{
+public:
+	static constexpr int32 WindowSize = 256;
+
+	void AddSample(double LatencySeconds);
+	const FHandTrackingLatencyStats& GetStats() const;
+	void Reset();
+
+private:
+	float SamplesMs[WindowSize];
+	int32 NextIndex = 0;
+	int32 SampleCount = 0;
+
+	mutable FHandTrackingLatencyStats CachedStats;
+	mutable bool bStatsDirty = false;
+};
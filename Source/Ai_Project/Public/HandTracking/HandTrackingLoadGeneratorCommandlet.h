@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HandTracking/HandTrackingCompactCodec.h"
+#include "HandTracking/HandTrackingTypes.h"
+#include "HandTrackingLoadGeneratorCommandlet.generated.h"
+
+class FSocket;
+class FInternetAddr;
+
+/**
+ * 파이썬 트래커 대신 합성 손 움직임을 보내는 부하 생성기.
+ * 카메라도 외부 네트워크도 필요 없으므로 CI에서 ASocketClient/AAI_Pawn을 웹캠보다 훨씬 높은 주기로 몰아붙여
+ * 게임 스레드가 따라가지 못하기 시작하는 주기를 찾는 데 쓴다.
+ *
+ * UnrealEditor-Cmd Ai_Project.uproject -run=HandTrackingLoadGenerator [옵션]
+ *   -Transport=Tcp|Udp       Tcp: Port에서 게임의 접속을 기다린다, Udp: Address:Port로 데이터그램을 보내고 같은 소켓으로 제어 메시지를 받는다 (기본 Tcp)
+ *   -Format=Json|Binary|Compact  (기본 Json, 파이썬 트래커와 같은 형식)
+ *   -KeyframeInterval=30 -DeltaThreshold=0.0005 -FractionBits=13  Compact 인코더 설정
+ *   -Address=127.0.0.1 -Port=65431
+ *   -Rate=60                 초당 프레임 수 (1~1000)
+ *   -Hands=2                 0~2
+ *   -Duration=0              보낼 시간(초). 0이면 종료할 때까지
+ *   -Jitter=0                랜드마크 노이즈 표준편차 (정규화 좌표)
+ *   -TimingJitterMs=0        송신 시각 흔들림 표준편차 (밀리초)
+ *   -Loss=0                  프레임을 보내지 않을 확률 (0~1). 시퀀스 번호는 그대로 증가한다.
+ *   -LossBurst=1             손실이 일어나면 연달아 빠뜨릴 프레임 수
+ *   -Seed=0
+ *   -IgnoreControl           게임의 제어 메시지(주기, 손)를 따르지 않는다. 핑에는 계속 답한다.
+ *   -ClockOffsetMs=0 -ClockDriftPpm=0  캡처 시각과 핑 응답에 쓰는 트래커 시계를 엔진 시계에서 이만큼 어긋나게 한다 (시계 맞추기 확인용)
+ */
+UCLASS()
+class AI_PROJECT_API UHandTrackingLoadGeneratorCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHandTrackingLoadGeneratorCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	bool OpenSockets();
+	void CloseSockets();
+	// Tcp: 게임이 접속해 올 때까지 짧게 기다린다. 접속된 클라이언트가 있으면 true
+	bool AcceptClient();
+	// 프레임 하나를 보낸다. Tcp 클라이언트가 끊겼으면 false
+	bool SendFrame(const TArray<uint8>& Bytes);
+	// 게임이 보낸 제어 메시지와 핑을 소켓을 막지 않고 읽는다. Tcp는 접속한 소켓, Udp는 프레임을 보내는 소켓
+	// 핑에는 바로 답하고, 제어 메시지는 가장 최근 것만 PendingControlMessage에 둔다.
+	void PollControlSocket();
+	// 흉내 내는 트래커 시계 (초)
+	double GetTrackerTime(double Now) const;
+	// 목표 시각까지 기다린다. 1ms 이하 간격도 맞추도록 마지막에는 양보하며 기다린다.
+	// 핑 응답의 수신 시각이 프레임 간격만큼 밀리지 않도록 기다리는 동안에도 1ms마다 제어 소켓을 본다.
+	void WaitUntil(double TargetTime);
+
+	EHandTrackingTransport Transport = EHandTrackingTransport::Tcp;
+	EHandTrackingWireFormat WireFormat = EHandTrackingWireFormat::Json;
+	FString Address = TEXT("127.0.0.1");
+	int32 Port = 65431;
+
+	FSocket* ListenSocket = nullptr;
+	FSocket* ClientSocket = nullptr;
+	FSocket* DatagramSocket = nullptr;
+	TSharedPtr<FInternetAddr> RemoteAddr;
+
+	TUniquePtr<FHandTrackingCompactEncoder> CompactEncoder;
+
+	// 아직 줄바꿈을 받지 못한 제어 메시지 조각
+	TArray<uint8> ControlBuffer;
+	FHandTrackingControlMessage PendingControlMessage;
+	bool bHasPendingControlMessage = false;
+
+	double ClockOffsetSeconds = 0.0;
+	double ClockDrift = 0.0;
+	double ClockStartTime = 0.0;
+};
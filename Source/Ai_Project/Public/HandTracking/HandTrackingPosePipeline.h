@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Pipe.h"
+#include "Tasks/Task.h"
+#include "HandTracking/HandTrackingCalibration.h"
+#include "HandTracking/HandTrackingJitterBuffer.h"
+#include "HandTracking/HandTrackingPosePredictor.h"
+#include "HandTracking/HandTrackingTypes.h"
+#include <atomic>
+
+// 프레임 하나를 디코딩하는 태스크. 실패하면 결과가 null
+using FHandTrackingDecodeTask = UE::Tasks::TTask<TSharedPtr<const FHandTrackingFrame, ESPMode::ThreadSafe>>;
+
+// 파이프라인 설정 (UHandTrackingSettings에서 읽고, 폰의 MinLandmarkConfidence로 덮어쓴다)
+struct FHandTrackingPosePipelineParams
+{
+	FHandTrackingCalibration Calibration;
+	FHandTrackingFilterParams FilterParams;
+	float PlayoutDelay = 0.04f;
+	float AssumedCaptureLatency = 0.05f;
+	float MinLandmarkConfidence = 0.5f;
+
+	static FHandTrackingPosePipelineParams FromSettings();
+};
+
+// 게임 스레드가 그대로 적용하면 되는 손 자세 (언리얼 좌표, EHandedness 값으로 인덱싱)
+struct FHandTrackingPipelineSnapshot
+{
+	// 손별로 마지막에 구한 랜드마크 (필터/보간/예측을 거친 값). 아직 본 적 없는 손은 ValidMask가 0
+	FHandFrame Hands[MaxTrackedHands];
+	FHandTrackingHandPose Poses[MaxTrackedHands];
+	FHandTrackingJitterBufferStats JitterStats[MaxTrackedHands];
+	// 다음 표시 시각에도 손이 움직일 수 있으면 true (보간 중이거나 이번에 바뀐 손이 있을 때)
+	bool bStillMoving = false;
+	// 이 자세까지 반영한 PushFrame 수
+	uint32 FrameCount = 0;
+	// 가장 최근에 반영한 프레임의 수신 시각과 엔진 시계 기준 캡처 시각. 모르면 0
+	double ArrivalTime = 0.0;
+	double CaptureTime = 0.0;
+};
+
+/**
+ * 트래커 스트림 하나의 좌표 변환 -> 필터 -> 지터 버퍼 -> 손가락 IK를 게임 스레드 밖에서 돌린다.
+ * 단계는 UE::Tasks 파이프 하나에 차례로 걸리므로 파이프라인 상태에는 락이 없다. 프레임이 오면 디코딩 태스크 바로 뒤에 이어 붙는다.
+ * 결과는 삼중 버퍼로 내놓는다. 파이프는 뒤 버퍼에 쓰고 가운데와 바꾸며, 게임 스레드는 AcquireLatest에서 원자적 교환 한 번으로 앞 버퍼와 바꿔 읽는다.
+ * 게임 스레드는 읽는 동안 기다리지 않고, 파이프는 게임 스레드가 아직 가져가지 않은 자세를 새 것으로 덮는다.
+ */
+class AI_PROJECT_API FHandTrackingPosePipeline
+{
+public:
+	FHandTrackingPosePipeline(int32 InStreamId, const FHandTrackingPosePipelineParams& InParams);
+	// 걸려 있는 태스크가 끝날 때까지 기다린다.
+	~FHandTrackingPosePipeline();
+
+	int32 GetStreamId() const { return StreamId; }
+
+	// 디코딩 태스크가 끝나면 그 프레임을 반영하고 자세를 다시 구한다.
+	void PushFrame(const FHandTrackingDecodeTask& DecodeTask);
+	// DisplayTime(FPlatformTime::Seconds 기준)에 보일 손을 다시 구한다. 이후 PushFrame도 이 시각에 맞춰 구한다.
+	void RequestDisplayTime(double DisplayTime);
+
+	// 게임 스레드 전용. 지난번 이후 새로 나온 자세가 있으면 그것, 없으면 null. 다음 호출까지 유효하다.
+	const FHandTrackingPipelineSnapshot* AcquireLatest();
+
+	// 걸려 있는 태스크가 다 끝날 때까지 기다린다.
+	void Flush();
+
+private:
+	// 아래는 파이프 태스크에서만 부른다.
+	void IngestFrame(const FHandTrackingFrame& Frame);
+	void SolveAndPublish();
+	double EstimateCaptureTime(const FHandTrackingFrame& Frame, double Now) const;
+
+	const int32 StreamId;
+	const FHandTrackingPosePipelineParams Params;
+
+	UE::Tasks::FPipe Pipe;
+
+	// 파이프 전용 상태
+	FHandTrackingPosePredictor HandPredictors[MaxTrackedHands];
+	FHandTrackingJitterBuffer HandJitterBuffers[MaxTrackedHands];
+	double TargetDisplayTime = 0.0;
+	// 평활한 캡처 -> 수신 지연(초). 지터 버퍼는 캡처 시각 기준이라 재생 시각도 이만큼 당긴다. 아직 모르면 음수
+	double CaptureLatency = -1.0;
+	// 마지막으로 구한 자세. 내놓을 때 뒤 버퍼로 복사한다.
+	FHandTrackingPipelineSnapshot State;
+
+	// 삼중 버퍼. BackIndex는 파이프, FrontIndex는 게임 스레드 전용. MiddleIndex에는 새 자세인지 나타내는 NewSnapshotFlag가 함께 들어 있다.
+	static constexpr int32 NewSnapshotFlag = 4;
+	FHandTrackingPipelineSnapshot Buffers[3];
+	int32 BackIndex = 0;
+	int32 FrontIndex = 1;
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<int32> MiddleIndex{2};
+};
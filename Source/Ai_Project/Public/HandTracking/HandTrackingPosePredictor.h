@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+// One-Euro 필터와 예측기 파라미터 (UHandTrackingSettings의 Filtering 항목)
+struct FHandTrackingFilterParams
+{
+	// 손이 멈춰 있을 때의 차단 주파수(Hz). 낮을수록 떨림이 줄고 느려진다.
+	float MinCutoff = 1.0f;
+	// 속도(단위/초)에 비례해 차단 주파수를 올리는 계수. 클수록 빠른 움직임에서 덜 늦는다.
+	float Beta = 0.02f;
+	// 속도/가속도 추정에 쓰는 차단 주파수(Hz)
+	float DerivativeCutoff = 1.0f;
+	// 이보다 멀리는 외삽하지 않는다(초). 트래킹이 끊겨도 손이 날아가지 않게 막는다.
+	float MaxPredictionHorizon = 0.1f;
+	// 표본 간격이 이보다 벌어지면 필터 상태를 버리고 새로 시작한다(초).
+	float ResetInterval = 0.5f;
+	bool bPredict = true;
+
+	static FHandTrackingFilterParams FromSettings();
+};
+
+/**
+ * 손 하나의 랜드마크를 One-Euro 필터로 다듬고, 필터가 추정한 속도/가속도로 원하는 시각까지 외삽한다.
+ * 측정값은 캡처 시각과 함께 넣고(AddSample), 매 프레임 화면에 보일 시각으로 꺼낸다(Predict).
+ * 상태는 FHandFrame과 같은 SoA 배열이라 랜드마크 4개씩 SIMD로 갱신한다. 게임 스레드 전용
+ */
+class AI_PROJECT_API FHandTrackingPosePredictor
+{
+public:
+	void SetParams(const FHandTrackingFilterParams& InParams) { Params = InParams; }
+
+	// 새 측정값 (언리얼 좌표). SampleTime은 FPlatformTime::Seconds 기준 캡처 시각
+	void AddSample(const FHandFrame& Hand, double SampleTime);
+	// 필터 결과를 TargetTime까지 외삽해 OutHand에 쓴다. 받은 표본이 없으면 false
+	bool Predict(double TargetTime, FHandFrame& OutHand) const;
+	// SampleTime에 본 손(예: 지터 버퍼에서 보간한 손)을 필터가 추정한 속도/가속도로 TargetTime까지 옮긴다. Hand와 OutHand는 같아도 된다.
+	// 받은 표본이 없으면 false이고 OutHand는 건드리지 않는다.
+	bool Advance(const FHandFrame& Hand, double SampleTime, double TargetTime, FHandFrame& OutHand) const;
+
+	// 마지막 표본까지 필터를 거친 손 (외삽 없음)
+	const FHandFrame& GetFiltered() const { return Filtered; }
+	bool HasState() const { return bHasState; }
+	double GetLastSampleTime() const { return LastSampleTime; }
+	void Reset();
+
+private:
+	FHandTrackingFilterParams Params;
+
+	// 필터를 거친 위치. 유효 비트와 신뢰도는 마지막 표본 그대로
+	FHandFrame Filtered;
+	float VelocityX[FHandFrame::PaddedLandmarkCount] = {};
+	float VelocityY[FHandFrame::PaddedLandmarkCount] = {};
+	float VelocityZ[FHandFrame::PaddedLandmarkCount] = {};
+	float AccelerationX[FHandFrame::PaddedLandmarkCount] = {};
+	float AccelerationY[FHandFrame::PaddedLandmarkCount] = {};
+	float AccelerationZ[FHandFrame::PaddedLandmarkCount] = {};
+
+	double LastSampleTime = 0.0;
+	bool bHasState = false;
+};
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * 트래커 <-> 언리얼 사이의 프레임 인코딩.
+ *
+ * 바이너리 프레임 (리틀 엔디언, 버전 1)
+ *   0  uint32  FrameSize       이 필드를 포함한 프레임 전체 바이트 수
+ *   4  uint16  Magic           'H' 'T'
+ *   6  uint8   Version         1
+ *   7  uint8   HandCount       0 ~ MaxTrackedHands
+ *   8  uint64  CaptureTimeUs   트래커 기준 캡처 시각 (마이크로초)
+ *  16  손 HandCount개, 각 256바이트
+ *        uint8     Handedness  0 = Left, 1 = Right
+ *        uint8[3]  Reserved
+ *        float[63] Landmarks   랜드마크 ID 0~20 순서의 x, y, z
+ *
+ * 압축 프레임: HandTrackingCompactCodec.h
+ *
+ * JSON 프레임 (기존 형식)
+ *   {"hands":[{"type":"Left","landmarks":[{"id":0,"x":..,"y":..,"z":..}, ...]}]}
+ *
+ * 제어 메시지 (게임 -> 트래커, ASocketClient::SendData와 같은 역방향 채널로 가는 UTF-8 JSON 한 줄)
+ *   UDP는 트래커가 프레임을 보낸 주소와 포트로 데이터그램 하나에 한 줄씩 보낸다. 트래커에게서 받은 게 없으면 보내지 않는다.
+ *   {"type":"control","seq":12,"rate":45.0,"headroom":0.231,"hands":["Left","Right"],"roi":[0.120,0.300,0.580,0.910]}
+ *   roi는 트래커 이미지 기준 정규화 좌표 (x0, y0, x1, y1). 빠져 있으면 화면 전체를 본다.
+ *
+ * 시계 맞추기 (NTP 방식, HandTrackingClockSync.h)
+ *   게임 -> 트래커 핑 (제어 메시지와 같은 채널의 JSON 한 줄). t0은 엔진 시계 마이크로초
+ *     {"type":"ping","seq":7,"t0":123456789012}
+ *   트래커 -> 게임 응답은 프레임 형식과 상관없이 아래 36바이트 프레임 하나. TCP는 프레임 사이에, UDP는 데이터그램 헤더 없이 단독으로 보낸다.
+ *   0  uint32  FrameSize       36
+ *   4  uint16  Magic           'H' 'K'
+ *   6  uint8   Version         1
+ *   7  uint8   Reserved
+ *   8  uint32  Sequence        핑의 seq
+ *  12  uint64  PingTimeUs      핑의 t0 그대로
+ *  20  uint64  ReceiveTimeUs   트래커가 핑을 받은 시각 (CaptureTimeUs와 같은 트래커 시계)
+ *  28  uint64  SendTimeUs      트래커가 응답을 보낸 시각
+ *   핑에 답하지 않는 트래커는 이전처럼 동작하고, 캡처 시각은 엔진 시계로 옮기지 않는다.
+ *
+ * UDP 데이터그램 = 16바이트 헤더 + 위 형식의 프레임 하나
+ *   0  uint32  Magic           'H' 'T' 'U' 'D'
+ *   4  uint32  Sequence        프레임마다 1씩 증가
+ *   8  uint64  CaptureTimeUs   트래커 기준 캡처 시각 (마이크로초)
+ */
+namespace HandTrackingProtocol
+{
+	constexpr uint16 BinaryMagic = 0x5448;
+	constexpr uint8 BinaryVersion = 1;
+	constexpr int32 BinaryHeaderSize = 16;
+	constexpr int32 BinaryHandSize = 4 + HandLandmarkCount * 3 * sizeof(float);
+	constexpr int32 MaxBinaryFrameSize = BinaryHeaderSize + MaxTrackedHands * BinaryHandSize;
+
+	constexpr uint32 DatagramMagic = 0x44555448;
+	constexpr int32 DatagramHeaderSize = 16;
+	// 한 데이터그램 최대 크기 (JSON 프레임도 들어갈 수 있도록 IPv4 UDP 최대치)
+	constexpr int32 MaxDatagramSize = 65507;
+
+	constexpr uint16 ClockMagic = 0x4B48;
+	constexpr uint8 ClockVersion = 1;
+	constexpr int32 ClockFrameSize = 36;
+
+	// 바이너리 프레임을 복사 없이 읽어 OutFrame에 채운다. FString/JSON 할당 없음
+	AI_PROJECT_API bool DecodeBinaryFrame(const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame);
+
+	// Frame을 바이너리 프레임으로 OutBytes 뒤에 붙인다. 붙인 바이트 수를 반환
+	AI_PROJECT_API int32 EncodeBinaryFrame(const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes);
+
+	// Frame을 기존 JSON 형식의 UTF-8 텍스트로 OutBytes 뒤에 붙인다. 붙인 바이트 수를 반환 (부하 생성기 등 송신 쪽용)
+	AI_PROJECT_API int32 EncodeJsonFrame(const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes);
+
+	// Format에 맞는 인코더를 고른다. Compact는 상태가 없는 이 함수에서는 항상 키프레임이므로 델타까지 보내려면 FHandTrackingCompactEncoder를 쓴다.
+	AI_PROJECT_API int32 EncodeFrame(EHandTrackingWireFormat Format, const FHandTrackingFrame& Frame, TArray<uint8>& OutBytes);
+
+	// 기존 JSON 형식을 파싱. 형식 전용 파서(HandTrackingJsonParser.h)로 먼저 읽고, 형식이 다르면 FJsonSerializer로 다시 시도한다.
+	AI_PROJECT_API bool ParseJsonFrame(const FString& Json, FHandTrackingFrame& OutFrame);
+
+	// UTF-8 바이트를 그대로 받아 형식에 맞게 디코딩. JSON도 형식이 맞으면 FString 변환 없이 바로 읽는다.
+	AI_PROJECT_API bool DecodeFrame(EHandTrackingWireFormat Format, const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame);
+
+	// 전송 방식에 맞게 받은 원본 프레임 하나를 디코딩한다. UDP는 데이터그램 헤더에서 시퀀스와 캡처 시각을 채운다. 스레드 안전
+	AI_PROJECT_API bool DecodeTransportFrame(EHandTrackingTransport Transport, EHandTrackingWireFormat Format, const uint8* Data, int32 Size, FHandTrackingFrame& OutFrame);
+
+	// 데이터그램 헤더를 읽는다. 헤더가 올바르지 않으면 false
+	AI_PROJECT_API bool ReadDatagramHeader(const uint8* Data, int32 Size, uint32& OutSequence, uint64& OutCaptureTimeUs);
+	AI_PROJECT_API void WriteDatagramHeader(TArray<uint8>& OutBytes, uint32 Sequence, uint64 CaptureTimeUs);
+
+	// 제어 메시지를 JSON 한 줄(끝에 '\n')로 OutBytes 뒤에 붙인다. 붙인 바이트 수를 반환
+	AI_PROJECT_API int32 EncodeControlMessage(const FHandTrackingControlMessage& Message, TArray<uint8>& OutBytes);
+	// 제어 메시지 한 줄을 읽는다 (트래커/부하 생성기 쪽). 제어 메시지가 아니면 false
+	AI_PROJECT_API bool ParseControlMessage(const FString& Json, FHandTrackingControlMessage& OutMessage);
+
+	// 핑을 JSON 한 줄로 OutBytes 뒤에 붙인다. 붙인 바이트 수를 반환
+	AI_PROJECT_API int32 EncodePing(uint32 Sequence, uint64 PingTimeUs, TArray<uint8>& OutBytes);
+	// 핑 한 줄을 읽는다 (트래커/부하 생성기 쪽). 핑이 아니면 false
+	AI_PROJECT_API bool ParsePing(const FString& Json, uint32& OutSequence, uint64& OutPingTimeUs);
+
+	// 시계 응답 프레임. Data가 응답 프레임 하나가 아니면 false
+	AI_PROJECT_API bool DecodeClockReply(const uint8* Data, int32 Size, FHandTrackingClockReply& OutReply);
+	AI_PROJECT_API int32 EncodeClockReply(const FHandTrackingClockReply& Reply, TArray<uint8>& OutBytes);
+
+	AI_PROJECT_API const TCHAR* GetHandednessName(EHandedness Handedness);
+}
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+// 트래커 주기 조절 파라미터 (UHandTrackingSettings의 Rate Control 항목)
+struct FHandTrackingRateControlParams
+{
+	float TargetFrameRate = 60.0f;
+	float MinRate = 10.0f;
+	float MaxRate = 60.0f;
+	float InitialRate = 30.0f;
+	float LowHeadroom = 0.1f;
+	float HighHeadroom = 0.3f;
+	float DecreaseFactor = 0.75f;
+	float IncreaseStep = 5.0f;
+	float IncreaseHoldTime = 1.0f;
+	float ControlInterval = 0.25f;
+	float KeepAliveInterval = 1.0f;
+	float RegionOfInterestMargin = 0.25f;
+	// 트래커 좌표를 0~1로 바꿀 때 나누는 이미지 크기
+	FVector2f TrackerImageSize = FVector2f(1.0f, 1.0f);
+	// 여유를 평활하는 시상수(초)
+	float HeadroomTimeConstant = 0.5f;
+
+	static FHandTrackingRateControlParams FromSettings();
+};
+
+/**
+ * 게임의 프레임 여유로 트래커에 요청할 주기를 정하고 제어 메시지를 만든다. 연결(ASocketClient)마다 하나, 게임 스레드 전용
+ * 예산을 넘기면 곱으로 빨리 줄이고, 여유가 한동안 이어질 때만 더해서 천천히 올린다 (AIMD). 받아서 버리는 대신 덜 받도록
+ * 트래커 쪽에서 줄이게 하고, 여유가 생기면 주기를 올려 프레임 간격만큼의 지연을 줄인다.
+ * 관심 영역은 마지막으로 받은 손 랜드마크의 경계 상자를 넓힌 것이고, 손이 없으면 보내지 않아 트래커가 화면 전체를 다시 찾게 한다.
+ */
+class AI_PROJECT_API FHandTrackingRateController
+{
+public:
+	FHandTrackingRateController();
+
+	void SetParams(const FHandTrackingRateControlParams& InParams);
+
+	// 디코딩한 프레임(트래커 좌표)으로 관심 영역을 갱신한다. HandMask에 없는 손은 영역에 넣지 않는다.
+	void ObserveFrame(const FHandTrackingFrame& Frame, uint8 HandMask);
+
+	// 매 틱 부른다. FrameSeconds는 지난 프레임의 게임/렌더 스레드 시간 중 큰 값. 보낼 메시지가 있으면 OutMessage를 채우고 true
+	bool Update(double Now, float FrameSeconds, uint8 HandMask, FHandTrackingControlMessage& OutMessage);
+
+	// 새로 접속한 트래커는 이전 요청을 모르므로 다음 Update에서 바로 보낸다. 요청 주기는 유지한다.
+	void ForceResend() { bHasSent = false; }
+
+	float GetRequestedRate() const { return RequestedRate; }
+	float GetHeadroom() const { return SmoothedHeadroom; }
+
+private:
+	void UpdateRate(double Now, float FrameSeconds);
+	bool ShouldSend(double Now, uint8 HandMask) const;
+
+	FHandTrackingRateControlParams Params;
+
+	float RequestedRate = 30.0f;
+	float SmoothedHeadroom = 0.0f;
+	bool bHasHeadroom = false;
+	double LastUpdateTime = 0.0;
+	double LastRateChangeTime = 0.0;
+	// 여유가 HighHeadroom을 넘기 시작한 시각. 넘지 않으면 음수
+	double HighHeadroomSince = -1.0;
+
+	bool bHasRegion = false;
+	FBox2f Region = FBox2f(ForceInit);
+
+	bool bHasSent = false;
+	double LastSendTime = 0.0;
+	FHandTrackingControlMessage LastSent;
+	uint32 Sequence = 0;
+};
@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "HandTracking/HandTrackingClockSync.h"
+#include "HandTracking/HandTrackingCompactCodec.h"
+#include "HandTracking/HandTrackingFrameQueue.h"
+#include "HandTracking/HandTrackingFrameSource.h"
+#include "HandTracking/HandTrackingSequenceFilter.h"
+#include "HandTracking/HandTrackingStreamReassembler.h"
+
+class FSocket;
+class FInternetAddr;
+class FHandTrackingIoThread;
+class FHandTrackingRecorder;
+
+// 수신 스레드 설정. 게임 스레드에서 채워 넘긴다.
+struct FHandTrackingReceiveWorkerSettings
+{
+	EHandTrackingTransport Transport = EHandTrackingTransport::Tcp;
+	EHandTrackingWireFormat WireFormat = EHandTrackingWireFormat::Json;
+
+	// Tcp: 접속할 트래커 주소, Udp: Port에 바인딩하고 보낼 데이터는 마지막으로 데이터그램을 보낸 트래커 주소로
+	FIPv4Address Address = FIPv4Address(127, 0, 0, 1);
+	int32 Port = 65431;
+
+	// Tcp: 접속 한 번을 기다리는 시간, Udp: 첫 데이터그램을 기다리는 시간이자 이만큼 아무것도 오지 않으면 끊긴 것으로 본다.
+	float ConnectTimeoutSeconds = 2.0f;
+	float InitialReconnectDelaySeconds = 0.25f;
+	float MaxReconnectDelaySeconds = 5.0f;
+
+	// 시계를 맞추는 핑 간격(초). 0이면 보내지 않는다. 접속 직후에는 이보다 촘촘히 몇 번 보낸다.
+	float ClockSyncInterval = 1.0f;
+
+	// 설정되어 있으면 링에 넣는 모든 프레임을 도착 시각과 함께 기록한다.
+	TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> Recorder;
+};
+
+/**
+ * 트래커 소켓 하나를 관리하는 워커. 자기 스레드 없이 모든 워커가 FHandTrackingIoThread 하나에서 돈다.
+ * 접속(논블로킹, 타임아웃)과 끊김 감지, 지수 백오프 재접속까지 모두 I/O 스레드에서 처리하므로 게임 스레드는 트래커를 기다리지 않는다.
+ * TCP는 스트림을 프레임 단위로 재조립하고, UDP는 시퀀스 번호로 늦은/중복 데이터그램을 걸러낸다.
+ * 남은 최신 프레임은 락프리 링에 쌓이고, 게임 스레드는 PopLatestFrame으로 가장 최근 프레임만 가져간다.
+ * UDP 프레임은 데이터그램 헤더를 포함한 그대로 전달된다. Compact 델타 프레임은 기준 키프레임을 앞에 붙여 전달한다.
+ */
+class AI_PROJECT_API FHandTrackingReceiveWorker : public IHandTrackingFrameSource
+{
+public:
+	FHandTrackingReceiveWorker(const FHandTrackingReceiveWorkerSettings& InSettings, FConnectionStateCallback InOnConnectionStateChanged);
+	virtual ~FHandTrackingReceiveWorker() override;
+
+	// 공유 I/O 스레드에 붙는다. 스레드를 띄우지 못했으면 false
+	bool Start();
+
+	//~ Begin IHandTrackingFrameSource Interface
+	virtual bool PopLatestFrame(FHandTrackingRawFrame& OutFrame) override;
+	// DroppedFrames에는 재조립 단계에서 버린 프레임도 포함된다.
+	virtual FHandTrackingReceiveStats GetStats() const override;
+	virtual bool Send(TArray<uint8>&& Data) override;
+	virtual EHandTrackingConnectionState GetConnectionState() const override;
+	virtual FHandTrackingClockEstimate GetClockEstimate() const override;
+	virtual void Shutdown() override;
+	//~ End IHandTrackingFrameSource Interface
+
+	// I/O 스레드 전용. 기다리지 않고 지금 할 수 있는 일만 한다. 무언가 했으면 true
+	bool Service(double Now);
+
+private:
+	enum class EPhase : uint8
+	{
+		// NextAttemptTime까지 기다렸다가 소켓을 연다.
+		WaitingToConnect,
+		// 논블로킹 TCP 접속이 끝나기를 기다린다.
+		Connecting,
+		Connected,
+	};
+
+	bool OpenSocket();
+	bool BeginConnectStreamSocket();
+	bool BindDatagramSocket();
+	void CloseSocket();
+	void SetConnectionState(EHandTrackingConnectionState NewState);
+	void OnSocketConnected();
+	// 접속에 실패했거나 끊겼다. 백오프 후 다시 시도한다.
+	void ScheduleReconnect(double Now);
+
+	// 읽을 수 있는 데이터를 모두 처리한다. 연결이 끊겼으면 false
+	bool ReceiveStream();
+	bool ReceiveDatagrams();
+	// Udp: 방금 받은 데이터그램을 보낸 쪽을 역방향 메시지의 목적지로 삼는다.
+	void UpdateRemoteAddr();
+	// 게임 스레드가 보낸 데이터를 전송한다. 연결이 끊겼으면 false
+	bool FlushOutgoing();
+	// 때가 되었으면 핑을 송신 대기열에 넣는다.
+	void SendPingIfDue(double Now);
+	void HandleClockReply(const FHandTrackingClockReply& Reply, double ReceiveTime);
+	void ResetClockSync();
+
+	// 접속 직후 ClockSyncBurstInterval 간격으로 보내는 핑 수. 첫 추정을 빨리 안정시킨다.
+	static constexpr int32 ClockSyncBurstCount = 8;
+	static constexpr float ClockSyncBurstInterval = 0.1f;
+
+	// 밀린 데이터를 한 번에 비울 수 있도록 넉넉하게 잡는다.
+	static constexpr int32 ReceiveBufferSize = 64 * 1024;
+
+	FHandTrackingReceiveWorkerSettings Settings;
+	FConnectionStateCallback OnConnectionStateChanged;
+
+	TSharedPtr<FHandTrackingIoThread, ESPMode::ThreadSafe> IoThread;
+
+	// 아래는 I/O 스레드 전용 (Start 전과 Shutdown 후에는 게임 스레드)
+	FSocket* Socket = nullptr;
+	// Tcp: 접속한 주소, Udp: 역방향 메시지를 보낼 트래커 주소 (받은 적 없으면 null)
+	TSharedPtr<FInternetAddr> RemoteAddr;
+	// Udp: RecvFrom이 채우는 보낸 쪽 주소
+	TSharedPtr<FInternetAddr> SenderAddr;
+	EPhase Phase = EPhase::WaitingToConnect;
+	double NextAttemptTime = 0.0;
+	double ConnectDeadline = 0.0;
+	float ReconnectDelay = 0.0f;
+	bool bHasConnected = false;
+	// Udp: 트래커에게서 마지막으로 데이터그램을 받은 시각. 바인딩한 뒤 아직 없으면 0
+	double LastDatagramTime = 0.0;
+
+	std::atomic<EHandTrackingConnectionState> ConnectionState{EHandTrackingConnectionState::Disconnected};
+
+	FHandTrackingFrameQueue FrameQueue;
+
+	TArray<uint8> ReceiveBuffer;
+	FHandTrackingStreamReassembler Reassembler;
+	TArray<uint8> ExtractedFrame;
+	FHandTrackingSequenceFilter SequenceFilter;
+	// UDP Compact: 마지막 키프레임과 델타를 붙인 프레임
+	FHandTrackingCompactKeyframeCache KeyframeCache;
+	TArray<uint8> ResolvedFrame;
+
+	// 게임 스레드 -> I/O 스레드 송신 대기열
+	TQueue<TArray<uint8>, EQueueMode::Mpsc> OutgoingQueue;
+	// TCP에서 일부만 보내진 메시지의 나머지
+	TArray<uint8> OutgoingRemainder;
+
+	// 시계 맞추기 (I/O 스레드). 추정값만 락을 잡고 게임 스레드에 내놓는다.
+	FHandTrackingClockSync ClockSync;
+	double NextPingTime = 0.0;
+	uint32 PingSequence = 0;
+	mutable FCriticalSection ClockEstimateLock;
+	FHandTrackingClockEstimate PublishedClockEstimate;
+
+	std::atomic<uint32> LostPacketCount{0};
+	std::atomic<uint32> ReorderedPacketCount{0};
+	std::atomic<uint32> DuplicatePacketCount{0};
+	std::atomic<uint32> ReconnectCount{0};
+};
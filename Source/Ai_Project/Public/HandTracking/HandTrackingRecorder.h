@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+#include <atomic>
+
+/**
+ * 녹화 파일 형식 (리틀 엔디언, 버전 1)
+ *   Header 16바이트
+ *     0  uint32  Magic          'H' 'T' 'R' 'C'
+ *     4  uint16  Version        1
+ *     6  uint8   Transport      EHandTrackingTransport (Udp면 각 프레임 앞에 데이터그램 헤더가 붙어 있다)
+ *     7  uint8   WireFormat     EHandTrackingWireFormat
+ *     8  uint64  StartTimeUs    녹화를 시작한 UTC 시각 (유닉스 epoch 기준 마이크로초, 참고용)
+ *   Record 반복
+ *     0  uint32  ArrivalDeltaUs 바로 앞 프레임(첫 프레임은 녹화 시작)부터 도착까지 걸린 시간
+ *     4  uint32  PayloadSize
+ *     8  수신 스레드가 링에 넣은 원본 프레임 그대로
+ */
+namespace HandTrackingRecording
+{
+	constexpr uint32 Magic = 0x43525448;
+	constexpr uint16 Version = 1;
+	constexpr int32 HeaderSize = 16;
+	constexpr int32 RecordHeaderSize = 8;
+
+	struct FHeader
+	{
+		EHandTrackingTransport Transport = EHandTrackingTransport::Tcp;
+		EHandTrackingWireFormat WireFormat = EHandTrackingWireFormat::Json;
+		uint64 StartTimeUs = 0;
+	};
+
+	AI_PROJECT_API void WriteHeader(FArchive& Ar, const FHeader& Header);
+	// 형식이 맞지 않으면 false
+	AI_PROJECT_API bool ReadHeader(FArchive& Ar, FHeader& OutHeader);
+}
+
+/**
+ * 수신한 원본 프레임을 도착 시각과 함께 파일에 기록한다.
+ * 같은 입력을 FHandTrackingReplaySource로 몇 번이고 다시 흘려 넣어 성능을 비교할 수 있다.
+ * RecordFrame은 수신 스레드에서 호출되므로 파일 쓰기는 락으로 보호한다.
+ */
+class AI_PROJECT_API FHandTrackingRecorder
+{
+public:
+	// 파일을 만들지 못하면 nullptr
+	static TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> Create(const FString& FilePath, EHandTrackingTransport Transport, EHandTrackingWireFormat WireFormat);
+
+	~FHandTrackingRecorder();
+
+	void RecordFrame(const uint8* Data, int32 Size);
+
+	int32 GetRecordedFrameCount() const { return RecordedFrameCount.load(std::memory_order_relaxed); }
+
+private:
+	FHandTrackingRecorder(TUniquePtr<FArchive>&& InWriter);
+
+	FCriticalSection WriterLock;
+	TUniquePtr<FArchive> Writer;
+	double LastArrivalTime = 0.0;
+	std::atomic<int32> RecordedFrameCount{0};
+};
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HandTracking/HandTrackingFrameQueue.h"
+#include "HandTracking/HandTrackingFrameSource.h"
+#include "HandTracking/HandTrackingRecorder.h"
+
+class FRunnableThread;
+
+struct FHandTrackingReplaySettings
+{
+	FString FilePath;
+	EHandTrackingReplayPacing Pacing = EHandTrackingReplayPacing::OriginalSpeed;
+	// Pacing == FixedRate일 때 초당 프레임 수
+	float FixedRate = 60.0f;
+	// 끝까지 재생하면 처음부터 다시
+	bool bLoop = false;
+};
+
+/**
+ * FHandTrackingRecorder로 녹화한 파일을 전용 스레드에서 읽어 수신 스레드와 같은 경로로 게임 스레드에 넘긴다.
+ * 트래커 없이도 같은 입력으로 파싱부터 메시 갱신까지 반복 측정할 수 있다.
+ * 녹화 당시의 전송 방식/형식은 GetRecordingHeader로 확인해 디코딩에 사용한다.
+ * 재생이 끝나면 연결 상태가 Disconnected로 바뀐다.
+ */
+class AI_PROJECT_API FHandTrackingReplaySource : public FRunnable, public IHandTrackingFrameSource
+{
+public:
+	FHandTrackingReplaySource(const FHandTrackingReplaySettings& InSettings, FConnectionStateCallback InOnConnectionStateChanged);
+	virtual ~FHandTrackingReplaySource() override;
+
+	// 파일을 열고 헤더를 확인한다.
+	bool Open();
+	bool Start();
+
+	const HandTrackingRecording::FHeader& GetRecordingHeader() const { return RecordingHeader; }
+
+	//~ Begin IHandTrackingFrameSource Interface
+	virtual bool PopLatestFrame(FHandTrackingRawFrame& OutFrame) override;
+	virtual FHandTrackingReceiveStats GetStats() const override;
+	virtual EHandTrackingConnectionState GetConnectionState() const override;
+	virtual void Shutdown() override;
+	//~ End IHandTrackingFrameSource Interface
+
+	//~ Begin FRunnable Interface
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	//~ End FRunnable Interface
+
+private:
+	// 다음 레코드를 ReplayFrame에 읽는다. 파일 끝이거나 잘린 레코드면 false
+	bool ReadNextRecord(uint32& OutArrivalDeltaUs);
+	void Rewind();
+	// 지정한 시각까지 기다린다. 종료 요청이 오면 false
+	bool WaitUntil(double TargetTime);
+	void SetConnectionState(EHandTrackingConnectionState NewState);
+
+	FHandTrackingReplaySettings Settings;
+	FConnectionStateCallback OnConnectionStateChanged;
+
+	TUniquePtr<FArchive> Reader;
+	HandTrackingRecording::FHeader RecordingHeader;
+
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopRequested{false};
+	std::atomic<EHandTrackingConnectionState> ConnectionState{EHandTrackingConnectionState::Disconnected};
+
+	FHandTrackingFrameQueue FrameQueue;
+	TArray<uint8> ReplayFrame;
+};
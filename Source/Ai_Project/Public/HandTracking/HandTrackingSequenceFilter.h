@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * UDP 데이터그램의 시퀀스 번호로 늦게 온 패킷, 중복 패킷을 걸러낸다.
+ * 가장 최근 시퀀스 기준 64개 창을 비트마스크로 기억해 중복과 순서 뒤바뀜을 구분하고,
+ * 건너뛴 번호는 손실로 센다. (뒤늦게 도착하면 손실에서 빼고 순서 뒤바뀜으로 옮김)
+ */
+class AI_PROJECT_API FHandTrackingSequenceFilter
+{
+public:
+	enum class EResult : uint8
+	{
+		Accepted,
+		Duplicate,
+		Late,
+	};
+
+	EResult Accept(uint32 Sequence);
+	void Reset();
+
+	uint32 GetAcceptedCount() const { return AcceptedCount; }
+	uint32 GetLostCount() const { return LostCount; }
+	uint32 GetReorderedCount() const { return ReorderedCount; }
+	uint32 GetDuplicateCount() const { return DuplicateCount; }
+
+	// 이 이상 뒤로 돌아간 시퀀스는 트래커가 재시작한 것으로 본다.
+	static constexpr int32 RestartThreshold = 1024;
+
+private:
+	static constexpr int32 WindowSize = 64;
+
+	bool bHasSequence = false;
+	uint32 LatestSequence = 0;
+	// 비트 i = LatestSequence - i 수신 여부
+	uint64 ReceivedWindow = 0;
+
+	uint32 AcceptedCount = 0;
+	uint32 LostCount = 0;
+	uint32 ReorderedCount = 0;
+	uint32 DuplicateCount = 0;
+};
@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "HandTrackingSettings.generated.h"
+
+/**
+ * 프로젝트 설정 > Game > Hand Tracking (DefaultGame.ini)
+ * 트래커 좌표 -> 언리얼 좌표 보정 값. 카메라 해상도나 배치가 바뀌면 다시 빌드하지 않고 여기만 고친다.
+ * 축 대응: 트래커 x -> 언리얼 Y, 트래커 y -> 언리얼 -Z (이미지 y는 아래로 증가), 트래커 z -> 언리얼 X
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Hand Tracking"))
+class AI_PROJECT_API UHandTrackingSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UHandTrackingSettings();
+
+	// 트래커 이미지 크기. 중앙이 언리얼 원점(+ UnrealOffset)으로 간다. 정규화 좌표를 보내는 트래커는 (1, 1)
+	UPROPERTY(Config, EditAnywhere, Category = "Calibration")
+	FVector2D TrackerImageSize = FVector2D(600.0, 580.0);
+
+	// 트래커 한 단위당 언리얼 단위 (X: 트래커 x, Y: 트래커 y, Z: 트래커 z)
+	UPROPERTY(Config, EditAnywhere, Category = "Calibration")
+	FVector TrackerScale = FVector(0.1, 0.05, 0.05);
+
+	// 변환한 뒤 더하는 언리얼 좌표 오프셋
+	UPROPERTY(Config, EditAnywhere, Category = "Calibration")
+	FVector UnrealOffset = FVector(0.0, 15.0, 0.0);
+
+	// One-Euro 필터: 손이 멈춰 있을 때의 차단 주파수(Hz). 낮을수록 떨림이 줄고 느려진다.
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering", meta = (ClampMin = "0.01"))
+	float FilterMinCutoff = 1.0f;
+
+	// One-Euro 필터: 속도(cm/s)에 비례해 차단 주파수를 올리는 계수. 클수록 빠른 움직임에서 덜 늦는다.
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering", meta = (ClampMin = "0.0"))
+	float FilterBeta = 0.02f;
+
+	// 속도/가속도 추정에 쓰는 차단 주파수(Hz)
+	UPROPERTY(Config, EditAnywhere, Category = "Filtering", meta = (ClampMin = "0.01"))
+	float FilterDerivativeCutoff = 1.0f;
+
+	// 지터 버퍼 재생 지연(초). 화면에 보일 시각에서 캡처 -> 수신 지연을 빼고 이만큼 더 앞선 캡처 시각의 손을 앞뒤 프레임 사이에서 보간한다.
+	// 트래커 프레임 간격(30 Hz면 0.033)보다 조금 크게 잡으면 도착이 흔들려도 매끄럽다. 0이면 보간 없이 예측만 한다.
+	UPROPERTY(Config, EditAnywhere, Category = "Playout", meta = (ClampMin = "0.0", ClampMax = "0.5"))
+	float PlayoutDelay = 0.04f;
+
+	// 캡처 시각부터 화면에 보일 시각까지 손 위치를 외삽한다.
+	UPROPERTY(Config, EditAnywhere, Category = "Prediction")
+	bool bEnablePrediction = true;
+
+	// 이보다 멀리는 외삽하지 않는다(초). 지터 버퍼에서 꺼낸 손도 표시 시각까지 이만큼만 앞당기므로 캡처 -> 수신 지연 + PlayoutDelay보다 크게 둔다.
+	UPROPERTY(Config, EditAnywhere, Category = "Prediction", meta = (ClampMin = "0.0", ClampMax = "0.5", EditCondition = "bEnablePrediction"))
+	float MaxPredictionHorizon = 0.1f;
+
+	// 트래커가 캡처 시각을 보내지 않을 때 수신 시각에서 빼는 캡처 -> 수신 지연(초). 웹캠 노출/전송/추론 시간
+	UPROPERTY(Config, EditAnywhere, Category = "Prediction", meta = (ClampMin = "0.0", EditCondition = "bEnablePrediction"))
+	float AssumedCaptureLatency = 0.05f;
+
+	// 게임 스레드에서 손을 옮긴 뒤 그 프레임이 화면에 나올 때까지 걸리는 프레임 수 (렌더 스레드 + GPU)
+	UPROPERTY(Config, EditAnywhere, Category = "Playout", meta = (ClampMin = "0.0"))
+	float DisplayLatencyFrames = 1.0f;
+
+	// 핸드 메시 위치가 이보다 적게 바뀌면 트랜스폼 갱신을 건너뛴다(cm).
+	UPROPERTY(Config, EditAnywhere, Category = "Apply", meta = (ClampMin = "0.0"))
+	float HandPositionEpsilon = 0.01f;
+
+	// 핸드 메시 회전이 이보다 적게 바뀌면 트랜스폼 갱신을 건너뛴다(도).
+	UPROPERTY(Config, EditAnywhere, Category = "Apply", meta = (ClampMin = "0.0"))
+	float HandRotationEpsilon = 0.05f;
+
+	// 게임의 프레임 여유와 원하는 주기, 관심 손/영역을 트래커에 알려 보내는 쪽에서 줄이게 한다.
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control")
+	bool bEnableRateControl = true;
+
+	// 프레임 여유를 잴 목표 프레임 속도. 게임/렌더 스레드 중 느린 쪽의 시간을 이 예산과 비교한다.
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "1.0", EditCondition = "bEnableRateControl"))
+	float RateControlTargetFrameRate = 60.0f;
+
+	// 트래커에 요청하는 초당 프레임 수의 범위와 처음 값
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "1.0", EditCondition = "bEnableRateControl"))
+	float MinTrackerRate = 10.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "1.0", EditCondition = "bEnableRateControl"))
+	float MaxTrackerRate = 60.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "1.0", EditCondition = "bEnableRateControl"))
+	float InitialTrackerRate = 30.0f;
+
+	// 평활한 여유가 이보다 낮으면 요청 주기를 RateDecreaseFactor배로 줄인다.
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMax = "1.0", EditCondition = "bEnableRateControl"))
+	float LowHeadroom = 0.1f;
+
+	// 평활한 여유가 이보다 높은 상태가 RateIncreaseHoldTime 동안 이어지면 RateIncreaseStep만큼 올린다.
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMax = "1.0", EditCondition = "bEnableRateControl"))
+	float HighHeadroom = 0.3f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "0.1", ClampMax = "1.0", EditCondition = "bEnableRateControl"))
+	float RateDecreaseFactor = 0.75f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "0.0", EditCondition = "bEnableRateControl"))
+	float RateIncreaseStep = 5.0f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "0.0", EditCondition = "bEnableRateControl"))
+	float RateIncreaseHoldTime = 1.0f;
+
+	// 제어 메시지를 보내는 최소 간격(초). 바뀐 것이 없어도 ControlKeepAliveInterval마다 다시 보낸다.
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "0.01", EditCondition = "bEnableRateControl"))
+	float ControlInterval = 0.25f;
+
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "0.1", EditCondition = "bEnableRateControl"))
+	float ControlKeepAliveInterval = 1.0f;
+
+	// 마지막 손 위치의 경계 상자를 크기의 이 비율만큼 사방으로 넓혀 관심 영역으로 보낸다.
+	UPROPERTY(Config, EditAnywhere, Category = "Rate Control", meta = (ClampMin = "0.0", EditCondition = "bEnableRateControl"))
+	float RegionOfInterestMargin = 0.25f;
+
+	// 트래커와 시계를 맞추는 핑 간격(초). 0이면 보내지 않고, 캡처 시각을 엔진 시계로 옮기지 않는다.
+	UPROPERTY(Config, EditAnywhere, Category = "Clock Sync", meta = (ClampMin = "0.0"))
+	float ClockSyncInterval = 1.0f;
+
+	// 위 값을 합친 아핀 변환 (행 벡터 규약, FMatrix와 같다)
+	FMatrix44f GetCalibrationMatrix() const;
+};
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformMemory.h"
+#include "HandTracking/HandTrackingFrameSource.h"
+
+class FHandTrackingRecorder;
+
+/**
+ * 같은 PC에서 도는 트래커와 이름 있는 공유 메모리로 프레임을 주고받는다.
+ * 루프백 TCP를 거치지 않고, 게임 스레드는 시스템 콜 없이 memcpy 한 번으로 최신 프레임을 읽는다.
+ *
+ * 레이아웃 (리틀 엔디언, 버전 1)
+ *   Header 64바이트
+ *     0  uint32  Magic        'H' 'T' 'S' 'M'
+ *     4  uint32  Version      1
+ *     8  uint32  SlotCount
+ *    12  uint32  SlotSize     슬롯 하나의 페이로드 최대 바이트 수
+ *    16  uint64  WriteCount   지금까지 쓴 프레임 수. 최신 슬롯 = (WriteCount - 1) % SlotCount
+ *   Slot[SlotCount], 각 16 + SlotSize 바이트
+ *     0  uint32  SeqLock      쓰는 중에는 홀수
+ *     4  uint32  PayloadSize
+ *     8  uint64  FrameIndex   이 슬롯에 담긴 프레임의 WriteCount - 1
+ *    16  바이너리 프레임 (HandTrackingProtocol.h)
+ *
+ * 쓰는 쪽: SeqLock += 1 -> FrameIndex, 페이로드 기록 -> SeqLock += 1 -> WriteCount += 1
+ * 읽는 쪽은 복사 앞뒤로 SeqLock과 FrameIndex를 비교해 링을 한 바퀴 돌아 덮어쓴 프레임을 버린다 (LostPackets).
+ */
+class AI_PROJECT_API FHandTrackingSharedMemorySource : public IHandTrackingFrameSource
+{
+public:
+	static constexpr uint32 Magic = 0x4D535448;
+	static constexpr uint32 Version = 1;
+	static constexpr int32 HeaderSize = 64;
+	static constexpr int32 SlotHeaderSize = 16;
+	static constexpr uint32 DefaultSlotCount = 8;
+
+	explicit FHandTrackingSharedMemorySource(const FString& InRegionName);
+	virtual ~FHandTrackingSharedMemorySource() override;
+
+	// 트래커가 만든 영역에 붙고, 아직 없으면 직접 만들어 헤더를 초기화한다.
+	bool Open();
+
+	// 설정되어 있으면 읽어 간 프레임을 도착 시각과 함께 기록한다.
+	void SetRecorder(TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> InRecorder) { Recorder = MoveTemp(InRecorder); }
+
+	//~ Begin IHandTrackingFrameSource Interface
+	virtual bool PopLatestFrame(FHandTrackingRawFrame& OutFrame) override;
+	virtual FHandTrackingReceiveStats GetStats() const override;
+	virtual EHandTrackingConnectionState GetConnectionState() const override;
+	virtual void Shutdown() override;
+	//~ End IHandTrackingFrameSource Interface
+
+	static SIZE_T GetRegionSize(uint32 SlotCount, uint32 SlotSize);
+
+private:
+	uint8* GetSlot(uint32 SlotIndex) const;
+	// WriteCount번째 프레임을 읽다가 덮어쓰였다. 잃은 프레임으로 세고 읽은 것으로 친다.
+	void ConsumeLostFrame(uint64 WriteCount);
+
+	FString RegionName;
+	FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+	uint8* BaseAddress = nullptr;
+	uint32 SlotCount = 0;
+	uint32 SlotSize = 0;
+
+	uint64 LastReadCount = 0;
+	FHandTrackingReceiveStats Stats;
+
+	TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> Recorder;
+};
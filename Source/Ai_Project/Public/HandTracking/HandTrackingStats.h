@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+
+// 0으로 정의하면 단계별 계측(stat/Insights 스코프)이 컴파일에서 빠진다. Shipping에서는 기본으로 빠진다.
+#ifndef HANDTRACKING_INSTRUMENTATION
+#define HANDTRACKING_INSTRUMENTATION !UE_BUILD_SHIPPING
+#endif
+
+// 프레임/랜드마크마다 찍는 로그는 VeryVerbose로 남기고 기본 빌드에서는 컴파일 단계에서 제거한다.
+// 디버깅할 때만 VeryVerbose로 올려서 빌드한다.
+#ifndef HANDTRACKING_LOG_COMPILE_VERBOSITY
+#define HANDTRACKING_LOG_COMPILE_VERBOSITY Verbose
+#endif
+
+DECLARE_LOG_CATEGORY_EXTERN(LogHandTracking, Log, HANDTRACKING_LOG_COMPILE_VERBOSITY);
+
+// stat HandTracking
+DECLARE_STATS_GROUP(TEXT("Hand Tracking"), STATGROUP_HandTracking, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Socket Receive"), STAT_HandTracking_Receive, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Frame Reassembly"), STAT_HandTracking_Reassembly, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Parse"), STAT_HandTracking_Parse, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Coordinate Conversion"), STAT_HandTracking_Convert, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Filtering"), STAT_HandTracking_Filter, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Finger IK"), STAT_HandTracking_Solve, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Mesh/Bone Apply"), STAT_HandTracking_Apply, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Anim Pose"), STAT_HandTracking_Pose, STATGROUP_HandTracking, AI_PROJECT_API);
+
+// 캡처 -> 적용 (트래커와 시계를 맞췄거나 트래커 시계가 FPlatformTime::Seconds와 같은 기준일 때만)
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Capture To Apply p50 (ms)"), STAT_HandTracking_EndToEndP50, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Capture To Apply p95 (ms)"), STAT_HandTracking_EndToEndP95, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Capture To Apply p99 (ms)"), STAT_HandTracking_EndToEndP99, STATGROUP_HandTracking, AI_PROJECT_API);
+// 캡처 -> 수신 (카메라, 추론, 네트워크. 조건은 위와 같다)
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Capture To Receive p50 (ms)"), STAT_HandTracking_CaptureToReceiveP50, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Capture To Receive p95 (ms)"), STAT_HandTracking_CaptureToReceiveP95, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Capture To Receive p99 (ms)"), STAT_HandTracking_CaptureToReceiveP99, STATGROUP_HandTracking, AI_PROJECT_API);
+// 수신 -> 적용
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Receive To Apply p50 (ms)"), STAT_HandTracking_ReceiveToApplyP50, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Receive To Apply p95 (ms)"), STAT_HandTracking_ReceiveToApplyP95, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Receive To Apply p99 (ms)"), STAT_HandTracking_ReceiveToApplyP99, STATGROUP_HandTracking, AI_PROJECT_API);
+
+// 지터 버퍼 (양손 중 깊은 쪽, 양손 누적)
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Jitter Buffer Depth"), STAT_HandTracking_JitterBufferDepth, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Jitter Buffer Underflows"), STAT_HandTracking_JitterUnderflows, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Jitter Buffer Overflows"), STAT_HandTracking_JitterOverflows, STATGROUP_HandTracking, AI_PROJECT_API);
+
+// 핸드 메시 트랜스폼 갱신. Updates는 적용한 갱신, Updates Saved는 변화가 작아 건너뛴 갱신 수
+// Render Transform Dirties는 실제로 더럽힌 렌더 트랜스폼 수, Saved는 예전 방식(손마다 매번 두 번 전파)보다 덜 더럽힌 수
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hand Transform Updates"), STAT_HandTracking_TransformUpdates, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Hand Transform Updates Saved"), STAT_HandTracking_TransformUpdatesSaved, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Render Transform Dirties"), STAT_HandTracking_RenderDirties, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Render Transform Dirties Saved"), STAT_HandTracking_RenderDirtiesSaved, STATGROUP_HandTracking, AI_PROJECT_API);
+
+// 트래커 주기 조절 (연결이 여럿이면 마지막 연결 기준)
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Requested Tracker Rate (Hz)"), STAT_HandTracking_RequestedRate, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Frame Headroom"), STAT_HandTracking_FrameHeadroom, STATGROUP_HandTracking, AI_PROJECT_API);
+
+// 트래커 시계 맞추기 (연결이 여럿이면 마지막 연결 기준)
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Tracker Clock Offset (ms)"), STAT_HandTracking_ClockOffset, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Tracker Clock Drift (ppm)"), STAT_HandTracking_ClockDrift, STATGROUP_HandTracking, AI_PROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Tracker Clock Round Trip (ms)"), STAT_HandTracking_ClockRoundTrip, STATGROUP_HandTracking, AI_PROJECT_API);
+
+// Insights: -trace=cpu,HandTracking
+UE_TRACE_CHANNEL_EXTERN(HandTrackingChannel, AI_PROJECT_API);
+
+// 파이프라인 단계 하나를 stat 카운터와 Insights 이벤트로 동시에 잰다. Stage는 Receive, Reassembly, Parse, Convert, Filter, Solve, Apply, Pose
+#if HANDTRACKING_INSTRUMENTATION
+#define HANDTRACKING_SCOPE(Stage) \
+	SCOPE_CYCLE_COUNTER(STAT_HandTracking_##Stage); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(HandTracking_##Stage, HandTrackingChannel)
+#else
+#define HANDTRACKING_SCOPE(Stage)
+#endif
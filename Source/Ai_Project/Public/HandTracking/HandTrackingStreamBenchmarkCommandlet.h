@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "HandTracking/HandTrackingTypes.h"
+#include "HandTrackingStreamBenchmarkCommandlet.generated.h"
+
+/**
+ * 트래커 스트림 수를 늘려 가며 게임 스레드 비용을 잰다.
+ * 스트림마다 UDP 수신 워커(공유 I/O 스레드)와 합성 움직임 송신 소켓을 하나씩 만들고,
+ * 게임 틱을 흉내 내어 AAI_Pawn/UHandTrackingSubsystem과 같은 순서(자세 꺼내기, 표시 시각 요청 -> 프레임 꺼내기 -> 디코딩 태스크 -> 스트림마다 FHandTrackingPosePipeline)로 처리한다.
+ * 게임에서는 디코딩과 포즈 파이프라인이 다음 틱까지 워커에서 돌지만, 여기서는 스트림당 전체 비용을 재려고 틱 안에서 끝까지 기다린다.
+ * 스트림 수마다 틱 시간 평균/p95/최대, 스트림당 비용, 그중 게임 스레드가 쓴 시간(GT) 평균을 찍는다.
+ *
+ * UnrealEditor-Cmd Ai_Project.uproject -run=HandTrackingStreamBenchmark [옵션]
+ *   -Streams=1,4,16          잴 스트림 수 목록
+ *   -Format=Json|Binary|Compact  (기본 Binary)
+ *   -Port=65440              스트림 i는 Port + i로 받는다
+ *   -Rate=30                 스트림마다 초당 프레임 수
+ *   -TickRate=90             흉내 낼 게임 틱 주기
+ *   -Duration=10             스트림 수마다 잴 시간(초)
+ */
+UCLASS()
+class AI_PROJECT_API UHandTrackingStreamBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UHandTrackingStreamBenchmarkCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+
+private:
+	struct FRunResult
+	{
+		int32 NumStreams = 0;
+		int32 NumTicks = 0;
+		int32 DecodedFrames = 0;
+		int32 DroppedFrames = 0;
+		int32 LostPackets = 0;
+		double MeanTickMicros = 0.0;
+		double P95TickMicros = 0.0;
+		double MaxTickMicros = 0.0;
+		// 태스크를 띄우기까지 게임 스레드가 쓴 시간
+		double MeanGameThreadMicros = 0.0;
+		double Seconds = 0.0;
+	};
+
+	bool RunStreams(int32 NumStreams, FRunResult& OutResult);
+
+	EHandTrackingWireFormat WireFormat = EHandTrackingWireFormat::Binary;
+	int32 BasePort = 65440;
+	float Rate = 30.0f;
+	float TickRate = 90.0f;
+	float DurationSeconds = 10.0f;
+};
@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingCompactCodec.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+/**
+ * TCP 바이트 스트림에서 트래커 프레임 경계를 복원한다.
+ * Recv 한 번이 프레임 하나라는 보장이 없으므로 받은 바이트를 계속 이어 붙이고,
+ * 완성된 프레임을 모두 잘라낸 뒤 가장 최근 프레임만 돌려준다. (latest-frame-wins)
+ *
+ * Json   : 최상위 '{' ... '}' 한 쌍이 프레임 하나 (줄바꿈 구분자가 없어도 동작)
+ * Binary : 헤더의 FrameSize 필드로 길이를 알 수 있음
+ * Compact: Binary와 같지만 버리는 프레임 중 키프레임은 기억해 두었다가 델타 프레임 앞에 붙여 돌려준다.
+ * 형식과 상관없이 프레임 사이에 끼어 온 시계 응답 프레임은 따로 모아 두고 최신 프레임 후보에서 뺀다.
+ */
+class AI_PROJECT_API FHandTrackingStreamReassembler
+{
+public:
+	explicit FHandTrackingStreamReassembler(EHandTrackingWireFormat InWireFormat = EHandTrackingWireFormat::Json);
+
+	void Append(const uint8* Data, int32 Size);
+
+	// 완성된 프레임이 하나 이상 있으면 가장 최근 프레임을 OutFrame에 복사한다.
+	// OutDroppedCount에는 이번에 버려진 오래된 프레임 수가 들어간다. Compact에서 기준 키프레임이 없는 델타만 있었으면 그것도 버린 수에 넣고 false
+	bool ExtractLatestFrame(TArray<uint8>& OutFrame, int32& OutDroppedCount);
+
+	void Reset();
+
+	// 지금까지 잘라낸 시계 응답. 받는 쪽이 처리하고 비운다.
+	TArray<FHandTrackingClockReply>& GetClockReplies() { return ClockReplies; }
+
+	int32 GetBufferedBytes() const { return Buffer.Num() - ReadOffset; }
+
+	// 프레임 경계를 찾지 못한 채 버퍼가 이 크기를 넘으면 스트림이 깨진 것으로 보고 비운다.
+	static constexpr int32 MaxBufferedBytes = 1024 * 1024;
+
+private:
+	// ReadOffset에서 시작하는 완성된 프레임의 끝(미포함)을 찾는다. 아직 덜 왔으면 INDEX_NONE
+	int32 FindJsonFrameEnd();
+	// FrameSize(uint32) + Magic(uint16)으로 시작하는 바이너리 계열 프레임
+	int32 FindSizedFrameEnd(uint16 Magic, int32 HeaderSize, int32 MaxFrameSize);
+	int32 FindFrameEnd();
+	// ReadOffset에 시계 응답 프레임이 있으면 그 크기, 앞부분만 와 있으면 INDEX_NONE, 아니면 0
+	int32 MatchClockReply() const;
+	void Compact();
+
+	EHandTrackingWireFormat WireFormat;
+
+	TArray<uint8> Buffer;
+	int32 ReadOffset = 0;
+
+	FHandTrackingCompactKeyframeCache KeyframeCache;
+	TArray<FHandTrackingClockReply> ClockReplies;
+
+	// JSON 스캔 상태. 덜 받은 프레임을 다음 Append 때 처음부터 다시 훑지 않도록 유지
+	int32 ScanOffset = 0;
+	int32 BraceDepth = 0;
+	bool bInString = false;
+	bool bEscaped = false;
+};
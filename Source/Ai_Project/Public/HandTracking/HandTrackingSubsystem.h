@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HandTracking/HandTrackingPosePipeline.h"
+#include "HandTracking/HandTrackingTypes.h"
+#include "SocketClient.h"
+#include "HandTrackingSubsystem.generated.h"
+
+// 디코딩이 끝난 프레임. 만든 뒤에는 바꾸지 않으므로 구독자끼리 복사 없이 나눠 가진다.
+using FHandTrackingFrameSnapshot = TSharedRef<const FHandTrackingFrame, ESPMode::ThreadSafe>;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHandTrackingFrameReceived, const FHandTrackingFrameSnapshot&);
+
+/**
+ * 월드의 트래커 연결을 한데 모아 프레임을 한 번만 꺼내 디코딩하고 구독자 모두에게 나눠 준다.
+ * ASocketClient는 BeginPlay에서 자기를 등록하고, 이 서브시스템이 매 프레임 액터 틱이 끝난 뒤 한 번 폴링한다.
+ * 새 프레임이 온 연결마다 디코딩 태스크를 띄우고, 그 스트림의 포즈 파이프라인(FHandTrackingPosePipeline)을 바로 뒤에 이어 붙인다.
+ * 그래서 프레임 N이 렌더링되는 동안 워커에서 다음 프레임을 디코딩하고 풀어 두고, 폰은 다음 틱에 결과만 적용한다.
+ * 프레임의 StreamId로 어느 연결인지 구분한다.
+ * 게임 스레드 구독자는 OnFrameReceived로 밀어 받거나 GetLatestFrame으로 당겨 읽는다. 디코딩 결과는 다음 액터 틱 전에 모아 알린다.
+ * 게임 스레드 전용
+ */
+UCLASS()
+class AI_PROJECT_API UHandTrackingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// UWorldSubsystem
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void RegisterClient(ASocketClient* Client);
+	void UnregisterClient(ASocketClient* Client);
+
+	// Pipeline->GetStreamId() 스트림의 프레임을 디코딩 태스크 뒤에 이어 넣는다.
+	// OnFrameQueued는 프레임을 넣기 직전 게임 스레드에서 부른다 (틱을 꺼 둔 폰을 깨우는 데 쓴다).
+	void RegisterPosePipeline(const TSharedRef<FHandTrackingPosePipeline, ESPMode::ThreadSafe>& Pipeline, FSimpleDelegate OnFrameQueued = FSimpleDelegate());
+	void UnregisterPosePipeline(const TSharedRef<FHandTrackingPosePipeline, ESPMode::ThreadSafe>& Pipeline);
+
+	// 새 프레임마다 한 번씩 (디코딩한 다음 프레임의 액터 틱 전)
+	FOnHandTrackingFrameReceived& OnFrameReceived() { return FrameReceived; }
+	// 가장 최근 프레임. 아직 받은 게 없으면 null
+	TSharedPtr<const FHandTrackingFrame, ESPMode::ThreadSafe> GetLatestFrame() const { return LatestFrame; }
+	// 지금까지 나눠 준 프레임 수. 당겨 읽는 쪽이 새 프레임인지 확인할 때 쓴다.
+	uint32 GetFrameCount() const { return FrameCount; }
+
+	// 등록된 연결 중 하나라도 붙어 있으면 Connected
+	UFUNCTION(BlueprintCallable, Category = "Hand Tracking")
+	EHandTrackingConnectionState GetConnectionState() const { return ConnectionState; }
+
+	// 등록된 연결을 합친 상태가 바뀔 때
+	UPROPERTY(BlueprintAssignable, Category = "Hand Tracking")
+	FOnHandTrackingConnectionStateChanged OnConnectionStateChanged;
+
+	static UHandTrackingSubsystem* Get(const UObject* WorldContextObject);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	// 액터 틱이 끝난 뒤: 새 프레임을 꺼내 디코딩 태스크와 포즈 파이프라인에 넘긴다.
+	void PumpFrames(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void HandlePreActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	// 다음 액터 틱 전: 끝난 디코딩 결과를 게임 스레드 구독자에게 알린다.
+	void DispatchDecodedFrames();
+	// 디코딩 태스크는 연결의 꺼낸 프레임 버퍼를 읽으므로 다시 꺼내거나 연결을 빼기 전에 기다린다.
+	void WaitForDecodes();
+	UFUNCTION()
+	void HandleClientConnectionStateChanged(EHandTrackingConnectionState NewState);
+	void UpdateConnectionState();
+
+	UPROPERTY()
+	TArray<TObjectPtr<ASocketClient>> Clients;
+
+	struct FPosePipelineEntry
+	{
+		TSharedRef<FHandTrackingPosePipeline, ESPMode::ThreadSafe> Pipeline;
+		FSimpleDelegate OnFrameQueued;
+	};
+	TArray<FPosePipelineEntry> PosePipelines;
+
+	// PumpFrames에서 매 프레임 재사용. DispatchDecodedFrames까지 PendingClients[i]의 디코딩이 DecodeTasks[i]
+	TArray<ASocketClient*> PendingClients;
+	TArray<FHandTrackingDecodeTask> DecodeTasks;
+
+	TSharedPtr<const FHandTrackingFrame, ESPMode::ThreadSafe> LatestFrame;
+	FOnHandTrackingFrameReceived FrameReceived;
+	uint32 FrameCount = 0;
+	EHandTrackingConnectionState ConnectionState = EHandTrackingConnectionState::Disconnected;
+
+	FDelegateHandle PreActorTickHandle;
+	FDelegateHandle PostActorTickHandle;
+};
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTracking/HandTrackingTypes.h"
+
+struct FHandTrackingSyntheticMotionSettings
+{
+	int32 NumHands = 2;
+	// 랜드마크마다 더하는 가우시안 노이즈의 표준편차 (정규화 이미지 좌표 단위)
+	float LandmarkJitter = 0.0f;
+	uint32 Seed = 0;
+};
+
+/**
+ * 카메라 없이 트래커 출력과 비슷한 손 움직임을 만든다.
+ * 좌표계는 MediaPipe 랜드마크와 같은 정규화 이미지 좌표(x, y는 0~1, z는 손목 기준 상대 깊이)이다.
+ * 손목은 화면 안에서 원을 그리고, 손가락은 서로 다른 위상으로 굽혔다 폈다 한다.
+ * 같은 시드로 같은 시각들을 차례로 넣으면 노이즈까지 같은 프레임 열이 나온다.
+ */
+class AI_PROJECT_API FHandTrackingSyntheticMotion
+{
+public:
+	explicit FHandTrackingSyntheticMotion(const FHandTrackingSyntheticMotionSettings& InSettings);
+
+	// TimeSeconds 시점의 손 자세를 OutFrame에 채운다. CaptureTimestamp와 Sequence는 건드리지 않는다.
+	void Generate(double TimeSeconds, FHandTrackingFrame& OutFrame);
+
+private:
+	void GenerateHand(double TimeSeconds, EHandedness Handedness, FHandFrame& OutHand);
+	float NextGaussian();
+
+	FHandTrackingSyntheticMotionSettings Settings;
+	FRandomStream RandomStream;
+};
@@ -0,0 +1,296 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HandTrackingTypes.generated.h"
+
+// MediaPipe 손 랜드마크 개수와 한 프레임에 담기는 최대 손 개수
+constexpr int32 HandLandmarkCount = 21;
+constexpr int32 MaxTrackedHands = 2;
+
+UENUM(BlueprintType)
+enum class EHandedness : uint8
+{
+	Left,
+	Right,
+};
+
+// 트래커가 보내는 데이터 형식
+UENUM(BlueprintType)
+enum class EHandTrackingWireFormat : uint8
+{
+	// 기존 파이썬 트래커 스크립트가 보내는 UTF-8 JSON 텍스트
+	Json,
+	// 길이가 앞에 붙는 버전 관리 바이너리 프레임 (HandTrackingProtocol.h 참고)
+	Binary,
+	// int16 양자화 + 키프레임/델타로 줄인 바이너리 프레임 (HandTrackingCompactCodec.h 참고)
+	Compact,
+};
+
+// 트래커와 주고받는 전송 방식
+UENUM(BlueprintType)
+enum class EHandTrackingTransport : uint8
+{
+	// 신뢰성 있는 스트림. 프레임 경계는 재조립으로 복원
+	Tcp,
+	// 데이터그램 하나에 프레임 하나. 늦거나 중복된 패킷은 버린다.
+	Udp,
+	// 같은 PC의 트래커와 이름 있는 공유 메모리 링 (바이너리 형식 전용)
+	SharedMemory,
+	// 녹화해 둔 파일을 다시 재생한다 (HandTrackingRecorder.h 참고)
+	Replay,
+};
+
+// 녹화 파일을 재생하는 속도
+UENUM(BlueprintType)
+enum class EHandTrackingReplayPacing : uint8
+{
+	// 녹화할 때의 도착 간격 그대로
+	OriginalSpeed,
+	// 녹화 간격과 상관없이 일정한 주기로
+	FixedRate,
+	// 게임 스레드가 이전 프레임을 가져가자마자 다음 프레임을 넣는다. 프레임을 버리지 않는다.
+	AsFastAsPossible,
+};
+
+// 트래커 연결 상태
+UENUM(BlueprintType)
+enum class EHandTrackingConnectionState : uint8
+{
+	Disconnected,
+	// 접속 시도 중 (재접속 대기 포함)
+	Connecting,
+	Connected,
+};
+
+// 수신 단계 통계 (누적)
+USTRUCT(BlueprintType)
+struct FHandTrackingReceiveStats
+{
+	GENERATED_BODY()
+
+	// 더 새로운 프레임에 밀려 적용되지 못하고 버려진 프레임 수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 DroppedFrames = 0;
+	// UDP: 끝내 도착하지 않은 시퀀스 수, 공유 메모리: 읽는 도중 덮어쓰여 버린 프레임 수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 LostPackets = 0;
+	// UDP: 더 새 프레임 뒤에 늦게 도착해 버린 패킷 수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 ReorderedPackets = 0;
+	// UDP: 같은 시퀀스가 다시 도착해 버린 패킷 수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 DuplicatePackets = 0;
+	// 연결이 끊긴 뒤 다시 접속한 횟수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 Reconnects = 0;
+};
+
+// 손 위치가 적용될 때까지 걸린 시간의 최근 분포
+USTRUCT(BlueprintType)
+struct FHandTrackingLatencyStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	float P50Ms = 0.0f;
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	float P95Ms = 0.0f;
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	float P99Ms = 0.0f;
+	// 분포를 계산한 표본 수 (최근 창 크기 이하)
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 SampleCount = 0;
+};
+
+// 손별 지터 버퍼 통계 (누적, BufferedFrames만 현재 값)
+USTRUCT(BlueprintType)
+struct FHandTrackingJitterBufferStats
+{
+	GENERATED_BODY()
+
+	// 지금 쌓여 있는 프레임 수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 BufferedFrames = 0;
+	// 재생 시각이 가장 새 프레임을 지나 보간하지 못하고 외삽한 렌더 프레임 수. 자주 늘면 재생 지연을 늘린다.
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 Underflows = 0;
+	// 버퍼가 가득 차 밀려난 프레임 수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 Overflows = 0;
+	// 재생 시각을 이미 지나 도착해 버린 프레임 수
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	int32 LateFrames = 0;
+};
+
+/**
+ * 손 하나의 랜드마크. 랜드마크 ID를 그대로 인덱스로 쓰는 고정 크기 SoA 버퍼
+ * 성분별 배열이 연속으로 놓여 있어 21개를 한 번에 훑는 변환/필터 루프가 캐시 한두 줄 안에서 끝난다.
+ * 디코딩 직후에는 트래커 좌표, AAI_Pawn에서 변환한 뒤에는 언리얼 좌표를 담는다.
+ */
+struct FHandFrame
+{
+	static constexpr uint32 AllLandmarksMask = (1u << HandLandmarkCount) - 1;
+	// 4개씩 묶어 처리하는 SIMD 루프가 꼬리 처리 없이 돌도록 배열 끝을 채운다. 21번 이후 칸은 쓰지 않는다.
+	static constexpr int32 PaddedLandmarkCount = Align(HandLandmarkCount, 4);
+
+	EHandedness Handedness = EHandedness::Right;
+	// 비트 i가 켜져 있으면 랜드마크 i가 이번 프레임에 들어왔다. 디코더는 꺼진 칸을 0으로 둔다.
+	uint32 ValidMask = 0;
+	float X[PaddedLandmarkCount] = {};
+	float Y[PaddedLandmarkCount] = {};
+	float Z[PaddedLandmarkCount] = {};
+	// 0 ~ 1. 신뢰도를 보내지 않는 형식은 들어온 랜드마크를 모두 1로 둔다.
+	float Confidence[PaddedLandmarkCount] = {};
+
+	void Reset(EHandedness InHandedness)
+	{
+		Handedness = InHandedness;
+		ValidMask = 0;
+		FMemory::Memzero(X);
+		FMemory::Memzero(Y);
+		FMemory::Memzero(Z);
+		FMemory::Memzero(Confidence);
+	}
+
+	void SetLandmark(int32 LandmarkId, float InX, float InY, float InZ, float InConfidence = 1.0f)
+	{
+		X[LandmarkId] = InX;
+		Y[LandmarkId] = InY;
+		Z[LandmarkId] = InZ;
+		Confidence[LandmarkId] = InConfidence;
+		ValidMask |= 1u << LandmarkId;
+	}
+
+	bool IsLandmarkValid(int32 LandmarkId) const { return (ValidMask & (1u << LandmarkId)) != 0; }
+	bool HasAllLandmarks() const { return ValidMask == AllLandmarksMask; }
+	int32 GetNumValidLandmarks() const { return FMath::CountBits(ValidMask); }
+	FVector3f GetPosition(int32 LandmarkId) const { return FVector3f(X[LandmarkId], Y[LandmarkId], Z[LandmarkId]); }
+
+	// 손, 유효 비트, 좌표, 신뢰도가 비트 단위로 같으면 true (구조체 패딩은 비교하지 않는다)
+	bool Equals(const FHandFrame& Other) const
+	{
+		return Handedness == Other.Handedness && ValidMask == Other.ValidMask
+			&& FMemory::Memcmp(X, Other.X, sizeof(X)) == 0
+			&& FMemory::Memcmp(Y, Other.Y, sizeof(Y)) == 0
+			&& FMemory::Memcmp(Z, Other.Z, sizeof(Z)) == 0
+			&& FMemory::Memcmp(Confidence, Other.Confidence, sizeof(Confidence)) == 0;
+	}
+};
+
+// 손가락 하나의 관절 각도 (라디안, 손바닥 좌표계 기준)
+struct FHandTrackingFingerPose
+{
+	// 손바닥 평면에서 손바닥 X축과 이루는 각도 (+는 Y축 쪽)
+	float Spread = 0.0f;
+	// 뿌리, 가운데, 끝 마디의 굽힘. 앞 마디에 대한 상대 각도이고 +는 -Z 쪽
+	float Flex[3] = {};
+};
+
+// 랜드마크에서 풀어낸 손 하나의 자세 (HandTrackingFingerSolver.h)
+struct FHandTrackingHandPose
+{
+	// 엄지, 검지, 중지, 약지, 새끼
+	static constexpr int32 NumFingers = 5;
+
+	// 손바닥 좌표계 -> 랜드마크 좌표계 회전. X: 손목 -> 중지 뿌리, Z: X x (새끼 뿌리 -> 검지 뿌리), Y = Z x X
+	FQuat4f PalmRotation = FQuat4f::Identity;
+	FHandTrackingFingerPose Fingers[NumFingers];
+	// 비트 i가 켜져 있으면 손가락 i를 풀었다. 손바닥을 못 풀면 0
+	uint8 ValidFingerMask = 0;
+	bool bPalmValid = false;
+};
+
+// 애니메이션 워커 스레드로 넘기는 손 하나의 자세. 게임 스레드에서 복사해 두고 워커는 복사본만 읽는다.
+struct FHandTrackingPoseSnapshot
+{
+	// 언리얼 좌표로 변환한 랜드마크
+	FHandFrame Hand;
+	// 랜드마크에서 푼 관절 각도
+	FHandTrackingHandPose Pose;
+	// 랜드마크 좌표계를 메시 컴포넌트 공간으로 돌리는 회전
+	FQuat LandmarkToComponent = FQuat::Identity;
+	bool bValid = false;
+};
+
+// 트래커 프레임 하나를 디코딩한 결과. 힙 할당이 없는 고정 크기 구조체
+struct FHandTrackingFrame
+{
+	// 트래커 기준 캡처 시각(초). 보내지 않는 트래커는 0
+	double CaptureTimestamp = 0.0;
+	// 트래커가 매기는 프레임 번호 (UDP 데이터그램 헤더). 없으면 0
+	uint32 Sequence = 0;
+	// 프레임을 받은 연결 (ASocketClient::StreamId). 구독자는 자기 스트림만 골라 쓴다.
+	int32 StreamId = 0;
+	// 원본 프레임이 수신 스레드에 도착한 시각 (FPlatformTime::Seconds). 디코딩 후 ASocketClient가 채운다.
+	double ArrivalTime = 0.0;
+	// CaptureTimestamp를 엔진 시계(FPlatformTime::Seconds)로 옮긴 값. 트래커와 시계를 맞추기 전이거나 캡처 시각이 없으면 0
+	double EngineCaptureTime = 0.0;
+	int32 NumHands = 0;
+	FHandFrame Hands[MaxTrackedHands];
+
+	void Reset()
+	{
+		CaptureTimestamp = 0.0;
+		Sequence = 0;
+		StreamId = 0;
+		ArrivalTime = 0.0;
+		EngineCaptureTime = 0.0;
+		NumHands = 0;
+	}
+
+	// 엔진 시계 기준 캡처 후 지난 시간(초). 모르면 음수
+	double GetCaptureAge(double Now) const
+	{
+		return (EngineCaptureTime > 0.0) ? Now - EngineCaptureTime : -1.0;
+	}
+};
+
+// 게임 -> 트래커 제어 메시지. 트래커는 보내는 주기와 손, 잘라 볼 영역을 여기에 맞춘다. (HandTrackingProtocol.h 참고)
+struct FHandTrackingControlMessage
+{
+	uint32 Sequence = 0;
+	// 게임이 받고 싶은 초당 프레임 수
+	float RequestedRate = 0.0f;
+	// 1 - 프레임 시간 / 목표 프레임 시간. 음수면 예산을 넘기고 있다.
+	float Headroom = 0.0f;
+	// 비트 i가 켜져 있으면 EHandedness i 손을 보내 달라는 뜻
+	uint8 HandMask = (1u << MaxTrackedHands) - 1;
+	// 트래커 이미지 기준 정규화 좌표 (0~1). 없으면 화면 전체를 본다.
+	bool bHasRegionOfInterest = false;
+	FBox2f RegionOfInterest = FBox2f(ForceInit);
+};
+
+// 트래커가 핑에 답한 시각들 (HandTrackingProtocol.h의 시계 응답 프레임)
+struct FHandTrackingClockReply
+{
+	uint32 Sequence = 0;
+	// 핑을 보낸 엔진 시각 (마이크로초, 핑에 담아 보낸 값을 그대로 돌려받는다)
+	uint64 PingTimeUs = 0;
+	// 트래커가 핑을 받은 시각과 응답을 보낸 시각 (트래커 시계, 마이크로초)
+	uint64 TrackerReceiveTimeUs = 0;
+	uint64 TrackerSendTimeUs = 0;
+};
+
+// 트래커 시계 -> 엔진 시계 변환 (HandTrackingClockSync.h)
+struct FHandTrackingClockEstimate
+{
+	// ReferenceTime(엔진 시계)에서 트래커 시계 - 엔진 시계(초)
+	double Offset = 0.0;
+	// 엔진 시계 1초당 Offset 변화 (트래커 시계가 빠르면 +)
+	double Drift = 0.0;
+	double ReferenceTime = 0.0;
+	// 추정에 쓴 가장 짧은 왕복 시간(초). 오프셋 오차는 이 값의 절반을 넘지 않는다.
+	double RoundTrip = 0.0;
+	int32 NumSamples = 0;
+
+	bool IsValid() const { return NumSamples > 0; }
+
+	double ToEngineTime(double TrackerTime) const
+	{
+		// Drift는 1e-3보다 훨씬 작으므로 엔진 시각을 한 번 근사해 넣어도 충분하다.
+		const double ApproxEngineTime = TrackerTime - Offset;
+		return TrackerTime - (Offset + Drift * (ApproxEngineTime - ReferenceTime));
+	}
+};
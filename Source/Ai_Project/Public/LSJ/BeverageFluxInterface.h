@@ -3,13 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "CDOBeverage.h"
 #include "UObject/Interface.h"
 #include "BeverageFluxInterface.generated.h"
 
+class ACDOBeverage;
 
-UENUM()
-enum EBeverage : UINT8
+
+UENUM(BlueprintType)
+enum EBeverage : uint8
 {
 	Lager,
 	Ale,
@@ -1,35 +0,0 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
-#include "BeverageUnit.generated.h"
-
-class UProjectileMovementComponent;
-
-UCLASS()
-class AI_PROJECT_API ABeverageUnit : public AActor
-{
-	GENERATED_BODY()
-
-public:
-	// Sets default values for this actor's properties
-	ABeverageUnit();
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
-	class UProjectileMovementComponent* ProjectileMoveComp;
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
-	class USphereComponent* SphereComp;
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
-	class UStaticMeshComponent* StaticMeshComp;
-	
-};
@@ -3,10 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "BeverageFluxInterface.h"
 #include "GameFramework/Actor.h"
 #include "CDOBeverage.generated.h"
 
+class UInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
 
+/**
+ * 음료 방울 풀. 방울마다 액터를 만들지 않고 위치/속도/남은 수명/음료 종류를 배열 따로따로(SoA) 들고 한 번에 적분한다.
+ * 그리기는 음료 종류마다 UInstancedStaticMeshComponent 하나. 방울에는 충돌이 없고 수명이 다하면 사라진다.
+ */
 UCLASS()
 class AI_PROJECT_API ACDOBeverage : public AActor
 {
@@ -20,20 +28,54 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
-	
+
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	// 한 번에 살아 있을 수 있는 방울 수. 가득 차면 새 방울을 만들지 않는다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	int32 CDOSize = 16384;
+
+	// 방울 메시와 음료별 머티리얼 (EBeverage 값으로 인덱싱, 비어 있으면 메시 기본 머티리얼)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	UStaticMesh* DropletMesh = nullptr;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TArray<UMaterialInterface*> BeverageMaterials;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float DropletScale = 0.02f;
+
+	// 방울 수명(초)과 공기 저항 (속도에 비례하는 감속, 1/초)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	int32 CDOSize = 100;
+	float DropletLifetime = 2.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
-	int32 CurrentPoolingBeverage = 0;
-	
-	UPROPERTY(EditDefaultsOnly)
-	TArray<class ABeverageUnit*> CDOBeverage;
-
-	UFUNCTION()
-	void NextPoolingBeverage();
-	
+	float DropletDrag = 0.5f;
+
+	// Location에서 Velocity 방향으로 Count개를 붓는다. 방향은 SpreadDegrees 원뿔 안에서 흩어진다. 실제로 만든 수를 반환
+	UFUNCTION(BlueprintCallable)
+	int32 SpawnDroplets(TEnumAsByte<EBeverage> Beverage, const FVector& Location, const FVector& Velocity, int32 Count = 1, float SpreadDegrees = 0.0f);
+
+	UFUNCTION(BlueprintCallable)
+	int32 GetNumDroplets() const { return Positions.Num(); }
+
+	UFUNCTION(BlueprintCallable)
+	void ClearDroplets();
+
+private:
+	// 모든 방울을 DeltaTime만큼 움직이고 수명이 다한 것은 뒤의 방울로 메운다.
+	void UpdateDroplets(float DeltaTime);
+	// 음료별 인스턴스 수를 살아 있는 방울 수에 맞추고 트랜스폼을 한 번에 올린다.
+	void UpdateInstances();
+
+	UPROPERTY(VisibleAnywhere)
+	TArray<UInstancedStaticMeshComponent*> BeverageMeshes;
+
+	// 방울 i의 상태 (빈 칸 없이 앞에서부터 채운다)
+	TArray<FVector3f> Positions;
+	TArray<FVector3f> Velocities;
+	TArray<float> Lifetimes;
+	TArray<uint8> Beverages;
+
+	// UpdateInstances에서 매 프레임 재사용
+	TArray<FTransform> InstanceTransforms[EBeverage::BeerMax];
 };
@@ -33,6 +33,26 @@ public:
 	UPROPERTY()
 	FBeverage Beverage;
 
-	UPROPERTY()
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	ACDOBeverage* ArrayCDOBeverage;
+
+	// 따르는 동안 초당 만들 방울 수, 방울 속도, 퍼짐 각도
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float PourRate = 2000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float PourSpeed = 150.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float PourSpreadDegrees = 5.0f;
+
+	// 손잡이를 당기고 놓을 때. 따르는 동안만 틱한다.
+	UFUNCTION(BlueprintCallable)
+	void SetPouring(bool bInPouring);
+
+	// 이번 틱에 쌓인 방울을 손잡이 아래에서 풀에 만든다.
+	virtual void DropBeverage(FBeverage BeverageStruct, ACDOBeverage* InCDOBeverage) override;
+
+private:
+	bool bPouring = false;
+	// 틱 사이에 쌓인, 아직 만들지 않은 방울 수 (소수 포함)
+	float PendingDroplets = 0.0f;
 };
@@ -5,8 +5,15 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "Interfaces/IPv4/IPv4Address.h"
+#include "HandTracking/HandTrackingFrameSource.h"
+#include "HandTracking/HandTrackingRateController.h"
+#include "HandTracking/HandTrackingTypes.h"
 #include "SocketClient.generated.h"
 
+class FHandTrackingRecorder;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnHandTrackingConnectionStateChanged, EHandTrackingConnectionState, NewState);
+
 UCLASS()
 class AI_PROJECT_API ASocketClient : public AActor
 {
@@ -18,6 +25,7 @@ public:
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	// Called every frame
@@ -29,12 +37,139 @@ public:
 
 	bool ReceiveData(FString& OutMessage);
 
-	FSocket* Socket;
+	// 가장 최근 프레임을 WireFormat에 맞게 디코딩해 가져온다.
+	bool ReceiveHandFrame(FHandTrackingFrame& OutFrame);
+	// ReceiveHandFrame을 둘로 나눈 것. 꺼내기는 게임 스레드에서, 디코딩은 아무 스레드에서나 (꺼낸 프레임 하나당 한 번)
+	bool PopPendingFrame();
+	bool DecodePendingFrame(FHandTrackingFrame& OutFrame) const;
+
+	// 제어 메시지 하나를 역방향 채널로 트래커에 보낸다 (HandTrackingProtocol.h). 보낼 수 없는 전송 방식이거나 연결이 없으면 false
+	bool SendControlMessage(const FHandTrackingControlMessage& Message);
+
+	// UHandTrackingSubsystem이 매 틱 부른다. 디코딩한 프레임으로 관심 영역을 갱신하고, 프레임 여유에 맞춰 요청 주기를 보낸다.
+	void ObserveDecodedFrame(const FHandTrackingFrame& Frame);
+	void UpdateRateControl(double Now, float FrameSeconds);
+
+	// 트래커에 마지막으로 요청한 초당 프레임 수
+	UFUNCTION(BlueprintCallable, Category = "Hand Tracking|Rate Control")
+	float GetRequestedTrackerRate() const { return RateController.GetRequestedRate(); }
+	const FHandTrackingRateController& GetRateController() const { return RateController; }
+
+	// 마지막 PopPendingFrame 때 받아 둔 트래커 시계 추정
+	const FHandTrackingClockEstimate& GetClockEstimate() const { return ClockEstimate; }
+
+	// 더 새로운 프레임에 밀려 적용되지 못하고 버려진 프레임 수
+	uint32 GetDroppedFrameCount() const;
+
+	// 버려진 프레임, UDP 손실/순서 뒤바뀜/중복 카운터
+	UFUNCTION(BlueprintCallable, Category = "Hand Tracking")
+	FHandTrackingReceiveStats GetReceiveStats() const;
+
+	void DisconnectFromServer();
+
+	// Tcp: 접속할 트래커 주소, Udp: 쓰지 않는다 (역방향 메시지는 마지막으로 데이터그램을 보낸 주소와 포트로 간다)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Connection")
 	FString Address = TEXT("127.0.0.1");
+	// 스트림마다 다른 포트를 쓴다 (Udp는 이 포트에서 받는다).
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Connection")
 	int32 Port = 65431;
 	FIPv4Address IP;
+
+	// 이 연결에서 받은 프레임에 붙는 번호. 같은 번호를 쓰는 AAI_Pawn이 이 스트림의 손을 맡는다.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking")
+	int32 StreamId = 0;
 	
-	bool bIsConnected;
+	bool bIsConnected = false;
+
+	// 트래커 연결 상태. 항상 게임 스레드에서 갱신된다.
+	UPROPERTY(BlueprintReadOnly, Category = "Hand Tracking")
+	EHandTrackingConnectionState ConnectionState = EHandTrackingConnectionState::Disconnected;
+
+	// 연결, 끊김, 재접속 시도 시 게임 스레드에서 호출
+	UPROPERTY(BlueprintAssignable, Category = "Hand Tracking")
+	FOnHandTrackingConnectionStateChanged OnConnectionStateChanged;
+
+	// 트래커에 보내 달라고 할 손. 끈 손은 트래커가 검출/전송을 건너뛸 수 있다.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand Tracking|Rate Control")
+	bool bWantLeftHand = true;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hand Tracking|Rate Control")
+	bool bWantRightHand = true;
+
+	// 접속 한 번을 기다리는 최대 시간 (Udp: 첫 데이터그램을 기다리는 시간. 이만큼 아무것도 오지 않으면 끊긴 것으로 본다)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Connection", meta = (ClampMin = "0.1"))
+	float ConnectTimeoutSeconds = 2.0f;
+	// 재접속 간격은 이 값에서 시작해 실패할 때마다 두 배로 늘어난다.
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Connection", meta = (ClampMin = "0.01"))
+	float InitialReconnectDelaySeconds = 0.25f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Connection", meta = (ClampMin = "0.01"))
+	float MaxReconnectDelaySeconds = 5.0f;
+
+	// Tcp: Address:Port로 접속, Udp: 로컬 Port에서 데이터그램 수신, SharedMemory: SharedMemoryName 영역을 직접 읽음, Replay: ReplayFilePath 재생
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking")
+	EHandTrackingTransport Transport = EHandTrackingTransport::Tcp;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking", meta = (EditCondition = "Transport == EHandTrackingTransport::SharedMemory"))
+	FString SharedMemoryName = TEXT("HandTrackingFrames");
+
+	// 트래커가 보내는 형식. 구버전 트래커 스크립트는 Json
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking")
+	EHandTrackingWireFormat WireFormat = EHandTrackingWireFormat::Json;
+
+	// 비어 있지 않으면 받은 원본 프레임을 도착 시각과 함께 이 파일에 녹화한다. (-HandTrackingRecord=)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Replay")
+	FString RecordFilePath;
+
+	// Transport == Replay일 때 재생할 녹화 파일 (-HandTrackingReplay=)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Replay", meta = (EditCondition = "Transport == EHandTrackingTransport::Replay"))
+	FString ReplayFilePath;
+
+	// (-HandTrackingReplayPacing=OriginalSpeed|FixedRate|AsFastAsPossible)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Replay", meta = (EditCondition = "Transport == EHandTrackingTransport::Replay"))
+	EHandTrackingReplayPacing ReplayPacing = EHandTrackingReplayPacing::OriginalSpeed;
+
+	// ReplayPacing == FixedRate일 때 초당 프레임 수 (-HandTrackingReplayRate=)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Replay", meta = (EditCondition = "Transport == EHandTrackingTransport::Replay", ClampMin = "1.0"))
+	float ReplayFixedRate = 60.0f;
+
+	// (-HandTrackingReplayLoop)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Replay", meta = (EditCondition = "Transport == EHandTrackingTransport::Replay"))
+	bool bLoopReplay = false;
+
+	// 재생이 끝나면 게임을 종료한다. 헤드리스 벤치마크용 (-HandTrackingReplayExit)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hand Tracking|Replay", meta = (EditCondition = "Transport == EHandTrackingTransport::Replay"))
+	bool bExitWhenReplayFinished = false;
 
 	FString ReceivedMessage;
+
+private:
+	// 명령줄 인수로 녹화/재생 설정을 덮어쓴다. 에디터 없이 같은 빌드로 벤치마크를 돌리기 위함
+	void ApplyCommandLineOverrides();
+	void OpenSharedMemory();
+	void StartReceiveWorker();
+	void StartReplay();
+	// 프레임 소스 스레드의 상태 알림을 게임 스레드로 넘기는 콜백
+	IHandTrackingFrameSource::FConnectionStateCallback MakeConnectionStateCallback();
+	void HandleConnectionStateChanged(EHandTrackingConnectionState NewState);
+	uint8 GetWantedHandMask() const;
+	// 역방향 채널이 있는 전송 방식 (Tcp, Udp)
+	bool HasBackChannel() const;
+
+	int32 ConnectionGeneration = 0;
+
+	// 받은 프레임을 해석할 때 쓰는 전송 방식/형식. 재생 중에는 녹화 당시의 값
+	EHandTrackingTransport FrameTransport = EHandTrackingTransport::Tcp;
+	EHandTrackingWireFormat FrameWireFormat = EHandTrackingWireFormat::Json;
+
+	TSharedPtr<FHandTrackingRecorder, ESPMode::ThreadSafe> Recorder;
+
+	FHandTrackingRateController RateController;
+	bool bRateControlEnabled = false;
+
+	FHandTrackingClockEstimate ClockEstimate;
+
+public:
+	// 소켓 수신 전용 스레드 또는 공유 메모리 (게임 스레드는 가장 최근 프레임만 꺼내 간다)
+	TUniquePtr<IHandTrackingFrameSource> FrameSource;
+	// ReceiveData에서 재사용하는 수신 버퍼
+	FHandTrackingRawFrame LatestFrameBuffer;
 };
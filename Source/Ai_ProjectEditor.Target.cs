@@ -11,5 +11,6 @@ public class Ai_ProjectEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V4;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_3;
 		ExtraModuleNames.Add("Ai_Project");
+		ExtraModuleNames.Add("Ai_ProjectEditor");
 	}
 }
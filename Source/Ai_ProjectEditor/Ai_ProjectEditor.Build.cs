@@ -0,0 +1,15 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class Ai_ProjectEditor : ModuleRules
+{
+	public Ai_ProjectEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "AnimGraph", "AnimGraphRuntime", "Ai_Project" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "BlueprintGraph", "UnrealEd" });
+	}
+}
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "AnimGraphNode_HandTrackingPose.h"
+
+#define LOCTEXT_NAMESPACE "AnimGraphNode_HandTrackingPose"
+
+FText UAnimGraphNode_HandTrackingPose::GetNodeTitle(ENodeTitleType::Type TitleType) const
+{
+	return GetControllerDescription();
+}
+
+FText UAnimGraphNode_HandTrackingPose::GetTooltipText() const
+{
+	return LOCTEXT("Tooltip", "Rotates finger bones toward the tracked hand landmarks published by the owning AI_Pawn. Requires a UAI_Anim based Anim Blueprint.");
+}
+
+FText UAnimGraphNode_HandTrackingPose::GetControllerDescription() const
+{
+	return LOCTEXT("ControllerDescription", "Hand Tracking Pose");
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimGraphNode_SkeletalControlBase.h"
+#include "HandTracking/AnimNode_HandTrackingPose.h"
+#include "AnimGraphNode_HandTrackingPose.generated.h"
+
+// 애님 그래프에 놓는 FAnimNode_HandTrackingPose 노드 (UAI_Anim 기반 애님 블루프린트에서 쓴다)
+UCLASS()
+class AI_PROJECTEDITOR_API UAnimGraphNode_HandTrackingPose : public UAnimGraphNode_SkeletalControlBase
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, Category = "Settings")
+	FAnimNode_HandTrackingPose Node;
+
+	// UEdGraphNode
+	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
+	virtual FText GetTooltipText() const override;
+
+protected:
+	// UAnimGraphNode_SkeletalControlBase
+	virtual FText GetControllerDescription() const override;
+	virtual const FAnimNode_SkeletalControlBase* GetNode() const override { return &Node; }
+};